@@ -4,7 +4,9 @@ namespace lsqecc::dag
 {
 
 /**
- * Instructions need to implement this trait to take advantage of parallelism in a dependancy dag
+ * Instructions need to implement this trait to take advantage of parallelism in a dependancy dag.
+ * Traits are default constructible objects, so that a specialization can carry settings of its own, like which
+ * instructions are taken to commute. Those without settings can keep their functions static
  */
 template <typename Instruction>
 struct CommutationTrait
@@ -12,7 +14,28 @@ struct CommutationTrait
     // Requirement:
     // Instructions commute -> maybe true
     // Instructions don't commute -> definitely false
-    static bool can_commute(const Instruction& a, const Instruction& b);
+    bool can_commute(const Instruction& a, const Instruction& b) const;
+};
+
+
+/**
+ * Instructions can implement this trait to build dependency dags incrementally (see IncrementalDependencyDagBuilder).
+ * Each instruction accesses resources, like patches or qubits, either exclusively or shared.
+ */
+template <typename Instruction>
+struct ResourceAccessTrait
+{
+    // Requirement:
+    // Two instructions don't commute according to the CommutationTrait exactly when they access a common resource
+    // and at least one of them accesses it exclusively, or both share it in different share groups
+    //
+    // using Resource = ...; // Hashable
+    //
+    // Calls f(const Resource& resource, bool shared) once for each resource accessed by the instruction. A shared
+    // access may also name its share group, f(resource, true, group), and then only commutes with shared accesses
+    // in the same group. The group defaults to 0
+    // template<typename F>
+    // void for_each_access(const Instruction& instruction, F&& f) const;
 };
 
 } // namespace lsqecc::dag
@@ -3,6 +3,9 @@
 #include <lsqecc/dag/directed_graph.hpp>
 #include <lsqecc/dag/commutation_trait.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -22,14 +25,14 @@ struct DependencyDag
 {
     using Self = DependencyDag<Instruction>;
 
-    label_t push_instruction_based_on_commutation(Instruction&& instruction)
+    label_t push_instruction_based_on_commutation(Instruction&& instruction, const CommutationTrait<Instruction>& commutation = {})
     {
         label_t new_instruction_label = add_instruction_isolated(std::move(instruction));
 
         for(label_t existing_instruction_label: graph_.topological_order_tails_first())
         {
             if(existing_instruction_label != new_instruction_label 
-               && !CommutationTrait<Instruction>::can_commute(instructions_.at(existing_instruction_label), instructions_.at(new_instruction_label)))
+               && !commutation.can_commute(instructions_.at(existing_instruction_label), instructions_.at(new_instruction_label)))
                 graph_.add_edge(existing_instruction_label, new_instruction_label);
         }
         return new_instruction_label;
@@ -43,18 +46,63 @@ struct DependencyDag
         return new_instruction_label;
     }
 
+    void add_dependency(label_t from, label_t to)
+    {
+        graph_.add_edge(from, to);
+    }
+
     bool empty() const
     {
         return graph_.empty();
     }
 
+    size_t size() const
+    {
+        return graph_.size();
+    }
+
+    bool contains(label_t label) const
+    {
+        return graph_.contains(label);
+    }
+
+    // Rough estimate of the heap memory held by the dag, not counting memory owned by the instructions themselves
+    size_t approximate_memory_bytes() const
+    {
+        return graph_.approximate_memory_bytes()
+               + instructions_.size()*(sizeof(std::pair<label_t, Instruction>) + 2*sizeof(size_t))
+               + (3*proximate_dependencies_.size() + proximate_heads_.size())*4*sizeof(label_t);
+    }
+
     std::vector<label_t> applicable_instructions() const
     {
-        std::vector<label_t> instructions;
-        for (auto& label: graph_.heads())
-            instructions.push_back(label);
+        return {graph_.ready_nodes().begin(), graph_.ready_nodes().end()};
+    }
 
-        return instructions;
+    // ASAP/ALAP levels of the instructions, indexed by label
+    TopologicalLevels levels() const
+    {
+        return graph_.topological_levels();
+    }
+
+    /**
+     * Weight of the heaviest path from each instruction to the end of the dag, counting the instruction itself.
+     * Instructions with a long remaining path are the ones holding back the rest of the computation.
+     */
+    template<typename WeightFunction>
+    std::unordered_map<label_t, size_t> remaining_critical_path(WeightFunction&& weight) const
+    {
+        const TopologicalLevels levels = graph_.topological_levels();
+        std::unordered_map<label_t, size_t> remaining;
+        remaining.reserve(levels.order.size());
+        for (auto it = levels.order.rbegin(); it != levels.order.rend(); ++it)
+        {
+            size_t longest_successor_path = 0;
+            for (label_t successor : graph_.successors(*it))
+                longest_successor_path = std::max(longest_successor_path, remaining.at(successor));
+            remaining[*it] = weight(instructions_.at(*it)) + longest_successor_path;
+        }
+        return remaining;
     }
 
     std::vector<label_t> proximate_instructions()
@@ -79,16 +127,23 @@ struct DependencyDag
     void pop_head(label_t label)
     {
         Instruction instruction = std::move(instructions_.at(label));
-        instructions_.erase(label);
+        instructions_.unordered_erase(label);
 
         for(label_t predecessor: graph_.predecessors(label))
         {
             if(proximate_dependencies_.contains({predecessor, label}))
             {
                 proximate_heads_.insert(predecessor);
-                proximate_dependencies_.erase({predecessor, label});
+                remove_proximate_dependency(predecessor, label);
             }
         }
+        // Proximate dependencies on the instruction are moot once it is gone
+        if (auto it = proximate_successors_.find(label); it != proximate_successors_.end())
+        {
+            auto successors = it->second;
+            for (label_t successor : successors)
+                remove_proximate_dependency(label, successor);
+        }
         graph_.remove_node(label);
 
         if(proximate_heads_.contains(label))
@@ -112,23 +167,29 @@ struct DependencyDag
         }
 
         graph_.expand(target, new_lables);
+        instructions_.unordered_erase(target);
         if(proximate)
             for (size_t i = 0; i < replacement.size()-1; i++)
-                proximate_dependencies_.insert({new_lables[i], new_lables[i+1]});
+                add_proximate_dependency(new_lables[i], new_lables[i+1]);
         
 
         // Now do the proximity bookkeeping for the extremes of the replacement
-        for (auto&[from, to]: proximate_dependencies_)
+        if (auto it = proximate_successors_.find(target); it != proximate_successors_.end())
         {
-            if (from == target)
+            auto successors = it->second;
+            for (label_t to : successors)
             {
-                proximate_dependencies_.erase({from, to});
-                proximate_dependencies_.insert({new_lables.back(), to});
+                remove_proximate_dependency(target, to);
+                add_proximate_dependency(new_lables.back(), to);
             }
-            if (to == target)
+        }
+        if (auto it = proximate_predecessors_.find(target); it != proximate_predecessors_.end())
+        {
+            auto predecessors = it->second;
+            for (label_t from : predecessors)
             {
-                proximate_dependencies_.erase({from, to});
-                proximate_dependencies_.insert({from, new_lables.front()});
+                remove_proximate_dependency(from, target);
+                add_proximate_dependency(from, new_lables.front());
             }
         }
 
@@ -175,18 +236,50 @@ struct DependencyDag
     }
 
 private:
+
+    void add_proximate_dependency(label_t from, label_t to)
+    {
+        if (proximate_dependencies_.insert({from, to}).second)
+        {
+            proximate_successors_[from].push_back(to);
+            proximate_predecessors_[to].push_back(from);
+        }
+    }
+
+    void remove_proximate_dependency(label_t from, label_t to)
+    {
+        proximate_dependencies_.unordered_erase({from, to});
+        auto erase_endpoint = [](std::unordered_map<label_t, std::vector<label_t>>& index, label_t key, label_t value)
+        {
+            auto it = index.find(key);
+            if (it == index.end())
+                return;
+            std::erase(it->second, value);
+            if (it->second.empty())
+                index.erase(it);
+        };
+        erase_endpoint(proximate_successors_, from, to);
+        erase_endpoint(proximate_predecessors_, to, from);
+    }
     
     // The directed graph representing the instructions and their dependencies. The graph_ only tracks the dependencies
-    // while the actual instructions are stored in the instructions_ map
+    // while the actual instructions are stored in the instructions_ map. Erasing from the middle of a tsl ordered
+    // container shifts everything after it, so instructions_ and proximate_dependencies_, whose order only matters to
+    // to_graphviz on dags that haven't been consumed yet, are erased from with unordered_erase
     DirectedGraph graph_;
     Map<label_t, Instruction> instructions_;
     
     // A set of pairs of instructions that have a proximate dependency relationship, these are instructions that must be
     // executed on subsequent slices
     SetOfPairs<label_t, label_t> proximate_dependencies_;
+
+    // proximate_dependencies_ indexed by each endpoint, so that expansions only touch the pairs of the target
+    std::unordered_map<label_t, std::vector<label_t>> proximate_successors_;
+    std::unordered_map<label_t, std::vector<label_t>> proximate_predecessors_;
     
     // When an instruction that had proximate dependencies is removed, the dependant instructions are added to this set
-    // to track the fact that they must be added to the next slices
+    // to track the fact that they must be added to the next slices. The order is the order they are applied in, so it
+    // is kept on erase, which is cheap as there is only one head per proximate chain under way
     Set<label_t> proximate_heads_;
     
     label_t current_label_ = 0;
@@ -195,6 +288,185 @@ private:
     friend const DirectedGraph& get_graph_for_testing(const DependencyDag<T>& g);
 };
 
+/**
+ * Builds a DependencyDag with the same dependencies as DependencyDag::push_instruction_based_on_commutation, up to
+ * transitivity, in time linear in the number of instructions and edges.
+ *
+ * Instead of checking the new instruction against the whole dag, it keeps, for each resource, the last instruction
+ * that accessed it exclusively and the instructions that shared it since. Only edges from this frontier are added,
+ * so edges implied by transitivity are left out. Shared accesses in different share groups don't commute, so a
+ * change of group closes the previous group, which then stands in for the last exclusive access.
+ * 
+ * Instructions must implement the ResourceAccessTrait.
+ */
+template<typename Instruction>
+class IncrementalDependencyDagBuilder
+{
+    using Access = ResourceAccessTrait<Instruction>;
+    using Resource = typename Access::Resource;
+
+public:
+    explicit IncrementalDependencyDagBuilder(Access access = {}) : access_(access) {}
+
+    label_t push_instruction(Instruction&& instruction)
+    {
+        label_t new_instruction_label = dag_.add_instruction_isolated(std::move(instruction));
+
+        auto add_dependency = [&](label_t existing_instruction_label)
+        {
+            if (existing_instruction_label != new_instruction_label && dag_.contains(existing_instruction_label))
+                dag_.add_dependency(existing_instruction_label, new_instruction_label);
+        };
+
+        access_.for_each_access(dag_.at(new_instruction_label), [&](const Resource& resource, bool shared, size_t share_group = 0)
+        {
+            ResourceFrontier& frontier = frontiers_[resource];
+            if (shared)
+            {
+                // Sharing in another group waits for the current group as a whole
+                if (!frontier.shared_since_barrier.empty() && frontier.share_group != share_group)
+                {
+                    for (label_t barrier_instruction_label : frontier.barrier)
+                        unlink(barrier_instruction_label, resource);
+                    frontier.barrier = std::move(frontier.shared_since_barrier);
+                    frontier.shared_since_barrier.clear();
+                }
+                for (label_t barrier_instruction_label : frontier.barrier)
+                    add_dependency(barrier_instruction_label);
+                frontier.shared_since_barrier.push_back(new_instruction_label);
+                frontier.share_group = share_group;
+            }
+            else
+            {
+                if (frontier.shared_since_barrier.empty())
+                {
+                    for (label_t barrier_instruction_label : frontier.barrier)
+                        add_dependency(barrier_instruction_label);
+                }
+                else
+                {
+                    for (label_t sharing_instruction_label : frontier.shared_since_barrier)
+                    {
+                        add_dependency(sharing_instruction_label);
+                        unlink(sharing_instruction_label, resource);
+                    }
+                    frontier.shared_since_barrier.clear();
+                }
+                for (label_t barrier_instruction_label : frontier.barrier)
+                    unlink(barrier_instruction_label, resource);
+                frontier.barrier.assign(1, new_instruction_label);
+            }
+            frontier_resources_[new_instruction_label].push_back(resource);
+        });
+
+        return new_instruction_label;
+    }
+
+    /**
+     * Same as DependencyDag::expand, to use when instructions are still pushed after the dag started being consumed.
+     * Later instructions that would have depended on the target depend on the end of the replacement instead.
+     */
+    label_t expand(label_t target, std::vector<Instruction>&& replacement, bool proximate)
+    {
+        size_t replacement_size = replacement.size();
+        label_t replacement_front = dag_.expand(target, std::move(replacement), proximate);
+        label_t replacement_back = replacement_front + replacement_size - 1;
+
+        auto it = frontier_resources_.find(target);
+        if (it == frontier_resources_.end())
+            return replacement_front;
+
+        std::vector<Resource> resources = std::move(it->second);
+        frontier_resources_.erase(it);
+        for (const Resource& resource : resources)
+        {
+            ResourceFrontier& frontier = frontiers_.at(resource);
+            std::replace(frontier.barrier.begin(), frontier.barrier.end(), target, replacement_back);
+            std::replace(frontier.shared_since_barrier.begin(), frontier.shared_since_barrier.end(), target, replacement_back);
+        }
+        frontier_resources_[replacement_back] = std::move(resources);
+
+        return replacement_front;
+    }
+
+    /**
+     * Same as DependencyDag::pop_head. Later pushes no longer depend on the instruction, and the frontiers of resources
+     * no instruction in the dag accesses any more are dropped, so that streaming through the builder keeps its memory
+     * bounded by the dag's size. Instructions must leave the dag this way rather than through dag().pop_head
+     */
+    void pop_head(label_t label)
+    {
+        dag_.pop_head(label);
+
+        auto it = frontier_resources_.find(label);
+        if (it == frontier_resources_.end())
+            return;
+        for (const Resource& resource : it->second)
+        {
+            auto frontier_it = frontiers_.find(resource);
+            std::erase(frontier_it->second.barrier, label);
+            std::erase(frontier_it->second.shared_since_barrier, label);
+            if (frontier_it->second.barrier.empty() && frontier_it->second.shared_since_barrier.empty())
+                frontiers_.erase(frontier_it);
+        }
+        frontier_resources_.erase(it);
+    }
+
+    // The dag being built
+    DependencyDag<Instruction>& dag()
+    {
+        return dag_;
+    }
+
+    // Same as DependencyDag::approximate_memory_bytes, counting the frontiers too
+    size_t approximate_memory_bytes() const
+    {
+        return dag_.approximate_memory_bytes()
+               + frontiers_.size()*(sizeof(std::pair<Resource, ResourceFrontier>) + 2*sizeof(size_t) + sizeof(label_t))
+               + frontier_resources_.size()*(sizeof(std::pair<label_t, std::vector<Resource>>) + 2*sizeof(size_t)
+                                             + sizeof(Resource));
+    }
+
+    DependencyDag<Instruction> release()
+    {
+        frontiers_.clear();
+        frontier_resources_.clear();
+        return std::move(dag_);
+    }
+
+private:
+
+    struct ResourceFrontier
+    {
+        // What any later access waits for: the last exclusive access, or the last group of shared accesses that
+        // was followed by sharing in another group
+        std::vector<label_t> barrier;
+        std::vector<label_t> shared_since_barrier;
+        size_t share_group = 0;
+    };
+
+    void unlink(label_t label, const Resource& resource)
+    {
+        auto it = frontier_resources_.find(label);
+        if (it == frontier_resources_.end())
+            return;
+        auto& resources = it->second;
+        auto resource_it = std::find(resources.begin(), resources.end(), resource);
+        if (resource_it != resources.end())
+            resources.erase(resource_it);
+        if (resources.empty())
+            frontier_resources_.erase(it);
+    }
+
+    Access access_;
+    DependencyDag<Instruction> dag_;
+    std::unordered_map<Resource, ResourceFrontier> frontiers_;
+
+    // The resources whose frontier contains each instruction, to follow expansions
+    std::unordered_map<label_t, std::vector<Resource>> frontier_resources_;
+};
+
+
 template<typename Instruction>
 std::string to_graphviz(const DependencyDag<Instruction>& dag)
 {
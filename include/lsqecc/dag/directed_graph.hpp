@@ -1,10 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
 #include <tsl/ordered_map.h>
 #include <tsl/ordered_set.h>
 #include <vector>
+#include <optional>
+#include <set>
 #include <ostream>
+#include <sstream>
+#include <string_view>
 #include <lstk/lstk.hpp>
 
 
@@ -24,6 +29,39 @@ template <typename S, typename T>
 using SetOfPairs = tsl::ordered_set<std::pair<S, T>, lstk::pair_hash<S,T>>;
 
 
+/**
+ * Result of a topological sort. Levels are indexed by label - first_label, entries of labels not in the graph are
+ * unused.
+ */
+struct TopologicalLevels
+{
+    label_t first_label = 0;
+
+    // Heads first
+    std::vector<label_t> order;
+
+    // Length of the longest path from a head to the node
+    std::vector<size_t> asap;
+
+    // Latest level the node can be at without lengthening the longest path of the graph
+    std::vector<size_t> alap;
+
+    // Number of levels, the number of nodes on the longest path
+    size_t depth = 0;
+
+    size_t asap_level(label_t label) const { return asap.at(label-first_label); }
+    size_t alap_level(label_t label) const { return alap.at(label-first_label); }
+};
+
+
+/**
+ * Directed graph over dense labels: nodes are stored in a deque indexed by their label, starting from the lowest
+ * label in the graph. Removed nodes are left as tombstones, so that removing a node only costs its degree, and are
+ * dropped once they are at the front. Nodes are iterated in label order.
+ *
+ * The heads (nodes without predecessors) are tracked as edges and nodes come and go, so they can be fetched in time
+ * proportional to their number.
+ */
 struct DirectedGraph 
 {
     void add_node(label_t label);
@@ -42,30 +80,63 @@ struct DirectedGraph
 
     Set<label_t> heads() const;
 
+    // Heads in label order
+    const std::set<label_t>& ready_nodes() const { return ready_nodes_; }
+
+    size_t in_degree(label_t label) const;
+
     Set<label_t> tails() const;
 
     bool empty() const;
 
+    bool contains(label_t label) const { return label >= first_label_ && label < end_label() && node(label).alive; }
+
+    size_t size() const { return node_count_; }
+
+    // Rough estimate of the heap memory held by the graph
+    size_t approximate_memory_bytes() const;
+
     std::vector<label_t> topological_order_tails_first() const;
 
+    // Kahn's algorithm. Throws if the graph has a cycle
+    TopologicalLevels topological_levels() const;
+
     std::ostream& to_graphviz(std::ostream& os, const Map<label_t,std::string>& nodes_contents, std::optional<std::stringstream>&& extra_content = std::nullopt) const;
 
 private:
-    // Minimal definition
-    Map<label_t, Set<label_t>> edges_;
-    
-    // Cached on the fly
-    Map<label_t, Set<label_t>> back_edges_;
+    using Adjacency = std::vector<label_t>;
+
+    struct Node
+    {
+        // In order of insertion
+        Adjacency successors;
+        Adjacency predecessors;
+        bool alive = false;
+    };
+
+    std::deque<Node> nodes_;
+    label_t first_label_ = 0;
+    size_t node_count_ = 0;
+    size_t edge_count_ = 0;
+    std::set<label_t> ready_nodes_;
+
+    label_t end_label() const { return first_label_ + nodes_.size(); }
+    const Node& node(label_t label) const { return nodes_[label-first_label_]; }
+    Node& node(label_t label) { return nodes_[label-first_label_]; }
+
+    const Node& node_or_fail(label_t label, std::string_view action) const;
+    Node& node_or_fail(label_t label, std::string_view action);
 
-    void topological_order_helper(label_t label, Set<label_t>& visited, std::vector<label_t>& order) const;
+    void topological_order_helper(label_t label, std::vector<bool>& visited, std::vector<label_t>& order) const;
 
-    friend const Map<label_t, Set<label_t>>& get_edges_for_testing(const DirectedGraph& g);
-    friend const Map<label_t, Set<label_t>>& get_back_edges_for_testing(const DirectedGraph& g);
+    friend Map<label_t, Set<label_t>> get_edges_for_testing(const DirectedGraph& g);
+    friend Map<label_t, Set<label_t>> get_back_edges_for_testing(const DirectedGraph& g);
 };
 
 
-const Map<label_t, Set<label_t>>& get_edges_for_testing(const DirectedGraph& g);
-const Map<label_t, Set<label_t>>& get_back_edges_for_testing(const DirectedGraph& g);
+// Adjacency of each node, keyed by node label
+Map<label_t, Set<label_t>> get_edges_for_testing(const DirectedGraph& g);
+Map<label_t, Set<label_t>> get_back_edges_for_testing(const DirectedGraph& g);
 
 } // namespace dag
 
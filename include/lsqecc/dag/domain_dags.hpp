@@ -8,7 +8,7 @@
 namespace lsqecc::dag {
 
 
-DependencyDag<LSInstruction> full_dependency_dag_from_instruction_stream(LSInstructionStream& instruction_stream);
+DependencyDag<LSInstruction> full_dependency_dag_from_instruction_stream(LSInstructionStream& instruction_stream, bool pauli_commutation);
 
 
 DependencyDag<gates::Gate> full_dependency_dag_from_gate_stream(GateStream& gate_stream);
@@ -88,8 +88,9 @@ struct ControlledGate
     static constexpr CNOTType default_cnot_type = CNOTType::ZX_WITH_MBM_CONTROL_FIRST;
     
     // Initialized in source file. This value is updated depending on the type of layout.
+    // Kept per thread, so that portfolio candidates, which slice on threads of their own, don't share it.
     // TODO consider using a more robust pattern if we have to support multiple layouts per lsqecc_slicer execution.
-    static CNOTAncillaPlacement default_ancilla_placement;
+    static thread_local CNOTAncillaPlacement default_ancilla_placement;
 };
 
 
@@ -176,6 +177,32 @@ struct CommutationTrait<gates::Gate>
     }
 };
 
+template<>
+struct ResourceAccessTrait<gates::Gate>
+{
+    using Resource = QubitNum;
+
+    // Controlled gates share their control qubit, so that gates controlled on the same qubit commute
+    template<typename F>
+    static void for_each_access(const gates::Gate& gate, F&& f)
+    {
+        std::visit(lstk::overloaded{
+            [&](const gates::ControlledGate& g){
+                f(g.control_qubit, true);
+                for (QubitNum qubit : std::visit(gates::get_operating_qubits, g.target_gate))
+                    f(qubit, false);
+            },
+            [&](const gates::Reset& g){
+                f(g.target_qubit, false);
+            },
+            [&](const auto&){
+                for (QubitNum qubit : gates::get_operating_qubits(gate))
+                    f(qubit, false);
+            }
+        }, gate);
+    }
+};
+
 }
 
 
@@ -23,6 +23,20 @@ std::optional<RoutingRegion> graph_search_route_ancilla(
         Heuristic heuristic
 );
 
+
+/**
+ * Breadth first search for routes with at least min_route_cells cells. Returns the shortest such route for each
+ * parity of the number of cells, even first. Used when the parity of a route changes how it is compiled.
+ */
+std::vector<RoutingRegion> graph_search_routes_by_parity(
+        const Slice& slice,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        size_t min_route_cells
+);
+
 }
 
 }
@@ -4,7 +4,9 @@
 #include <lsqecc/patches/sparse_slice.hpp>
 #include <lsqecc/patches/slice.hpp>
 
+#include <chrono>
 #include <unordered_map>
+#include <utility>
 
 namespace lsqecc {
 
@@ -15,6 +17,12 @@ enum class GraphSearchProvider
     AStar
 };
 
+enum class LocalRoutingMode
+{
+    ShortestPath, // Use the same route as non-local lattice surgery
+    ParityAware // Choose among the shortest routes of each parity, see find_routing_ancillas_by_parity
+};
+
 
 struct Router {
     virtual std::optional<RoutingRegion> find_routing_ancilla(
@@ -25,9 +33,25 @@ struct Router {
                 PauliOperator target_op
             ) const = 0;
 
+    // Shortest routes with at least min_route_cells cells, one for each parity of the number of cells
+    virtual std::vector<RoutingRegion> find_routing_ancillas_by_parity(
+                const Slice& slice,
+                PatchId source,
+                PauliOperator source_op,
+                PatchId target,
+                PauliOperator target_op,
+                size_t min_route_cells
+            ) const = 0;
+
     virtual void set_graph_search_provider(GraphSearchProvider graph_search_provider) = 0;
 
+    void set_local_routing_mode(LocalRoutingMode local_routing_mode) { local_routing_mode_ = local_routing_mode; }
+    LocalRoutingMode local_routing_mode() const { return local_routing_mode_; }
+
     virtual ~Router(){};
+
+private:
+    LocalRoutingMode local_routing_mode_ = LocalRoutingMode::ShortestPath;
 };
 
 
@@ -41,6 +65,15 @@ struct CustomDPRouter : public Router
             PauliOperator target_op
     ) const override;
 
+    std::vector<RoutingRegion> find_routing_ancillas_by_parity(
+            const Slice& slice,
+            PatchId source,
+            PauliOperator source_op,
+            PatchId target,
+            PauliOperator target_op,
+            size_t min_route_cells
+    ) const override;
+
     void set_graph_search_provider(GraphSearchProvider graph_search_provider) override {
         graph_search_provider_ = graph_search_provider;
     };
@@ -67,6 +100,15 @@ struct CachedRouter : public Router
             PauliOperator target_op
     ) const override;
 
+    // Not cached
+    std::vector<RoutingRegion> find_routing_ancillas_by_parity(
+            const Slice& slice,
+            PatchId source,
+            PauliOperator source_op,
+            PatchId target,
+            PauliOperator target_op,
+            size_t min_route_cells
+    ) const override;
 
     void set_graph_search_provider(GraphSearchProvider graph_search_provider) override {
         router_impl_.set_graph_search_provider(graph_search_provider);
@@ -91,6 +133,43 @@ private:
     CustomDPRouter router_impl_;
     mutable std::unordered_map<PathIdentifier, RoutingRegion, PathIdentifier::hash> cached_routes_;
 };
+
+
+/**
+ * Passes routing on to another router, adding up the time it takes
+ */
+struct TimedRouter : public Router
+{
+    explicit TimedRouter(Router& router) : router_(router) {}
+
+    std::optional<RoutingRegion> find_routing_ancilla(
+            const Slice& slice,
+            PatchId source,
+            PauliOperator source_op,
+            PatchId target,
+            PauliOperator target_op
+    ) const override;
+
+    std::vector<RoutingRegion> find_routing_ancillas_by_parity(
+            const Slice& slice,
+            PatchId source,
+            PauliOperator source_op,
+            PatchId target,
+            PauliOperator target_op,
+            size_t min_route_cells
+    ) const override;
+
+    void set_graph_search_provider(GraphSearchProvider graph_search_provider) override {
+        router_.set_graph_search_provider(graph_search_provider);
+    };
+
+    // Returns the time spent routing since the last call
+    std::chrono::nanoseconds take_routing_time() { return std::exchange(routing_time_, std::chrono::nanoseconds{0}); }
+
+private:
+    Router& router_;
+    mutable std::chrono::nanoseconds routing_time_{0};
+};
 }
 
 
@@ -96,6 +96,14 @@ std::ostream& operator<<(std::ostream& os, const TwoPatchMeasure& instruction);
 std::ostream& operator<<(std::ostream& os, const ExtendSplit& instruction);
 std::ostream& operator<<(std::ostream& os, const MergeContract& instruction);
 
+std::vector<Cell> get_operating_cells(const LocalLSInstruction& instruction);
+
+/**
+ * Number of slices it takes to apply a sequence of local instructions in order. An instruction has to wait for the
+ * next slice when one of its cells was already used by a previous instruction in the current slice.
+ */
+size_t local_instruction_depth(const std::vector<LocalLSInstruction>& instructions);
+
 template <class T>
 struct LocalInstructionPrint{};
 
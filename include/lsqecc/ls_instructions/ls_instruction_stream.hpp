@@ -4,6 +4,7 @@
 #include <lsqecc/ls_instructions/ls_instructions.hpp>
 #include <lsqecc/ls_instructions/ls_instructions_from_gates.hpp>
 #include <lsqecc/ls_instructions/id_generator.hpp>
+#include <lsqecc/ls_instructions/mapped_file.hpp>
 #include <lsqecc/gates/parse_gates.hpp>
 
 
@@ -49,6 +50,26 @@ private:
 };
 
 
+// Parses the lines in place in a memory mapped file, instead of reading each into a string
+class LSInstructionStreamFromMappedFile : public LSInstructionStream {
+public:
+    explicit LSInstructionStreamFromMappedFile(const std::string& path);
+
+    LSInstruction get_next_instruction() override;
+    bool has_next_instruction() const override {return next_instruction_.has_value();};
+    const tsl::ordered_set<PatchId>& core_qubits() const override {return core_qubits_;}
+
+private:
+    MappedFile file_;
+    lstk::Splitter lines_;
+    std::optional<LSInstruction> next_instruction_;
+    tsl::ordered_set<PatchId> core_qubits_;
+    size_t line_number_ = 0;
+
+    void advance_instruction();
+};
+
+
 class LSInstructionStreamFromGateStream : public LSInstructionStream {
 public:
     LSInstructionStreamFromGateStream(
@@ -1,6 +1,8 @@
 #ifndef LSQECC_LOGICAL_LATTICE_OPS_HPP
 #define LSQECC_LOGICAL_LATTICE_OPS_HPP
 
+#include <algorithm>
+#include <optional>
 #include <variant>
 #include <stdexcept>
 #include <ostream>
@@ -166,6 +168,8 @@ struct LSInstruction {
     
     tsl::ordered_set<PatchId> get_operating_patches() const;
     tsl::ordered_set<PatchId> get_patch_dependencies() const { return lstk::set_union(get_operating_patches(), clients); }
+    // The Pauli the instruction acts with on the patch, if it acts on it only through a single Pauli operator
+    std::optional<PauliOperator> pauli_basis_on(PatchId patch_id) const;
     bool operator==(const LSInstruction&) const = default;
 };
 
@@ -296,9 +300,46 @@ namespace dag {
 template<>
 struct CommutationTrait<LSInstruction>
 {
-    static bool can_commute(const LSInstruction& a, const LSInstruction& b)
+    // When set, instructions acting on their common patches with the same Pauli operators commute, like two Z basis
+    // measurements of a patch. Otherwise instructions on a common patch never do
+    bool pauli_commutation = false;
+
+    bool can_commute(const LSInstruction& a, const LSInstruction& b) const
+    {
+        auto common_patches = lstk::set_intersection(a.get_operating_patches(), b.get_operating_patches());
+        if (!pauli_commutation)
+            return common_patches.empty();
+        return std::all_of(common_patches.begin(), common_patches.end(), [&](PatchId patch_id)
+        {
+            auto basis = a.pauli_basis_on(patch_id);
+            return basis && basis == b.pauli_basis_on(patch_id);
+        });
+    }
+};
+
+template<>
+struct ResourceAccessTrait<LSInstruction>
+{
+    using Resource = PatchId;
+
+    // See CommutationTrait<LSInstruction>
+    bool pauli_commutation = false;
+
+    // With Pauli commutation, patches are shared by the instructions acting on them with the same Pauli
+    template<typename F>
+    void for_each_access(const LSInstruction& instruction, F&& f) const
     {
-        return lstk::set_intersection(a.get_operating_patches(), b.get_operating_patches()).empty();
+        for (PatchId patch_id : instruction.get_operating_patches())
+        {
+            std::optional<PauliOperator> basis;
+            if (pauli_commutation)
+                basis = instruction.pauli_basis_on(patch_id);
+
+            if (basis)
+                f(patch_id, true, static_cast<size_t>(*basis));
+            else
+                f(patch_id, false);
+        }
     }
 };
 
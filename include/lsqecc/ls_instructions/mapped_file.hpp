@@ -0,0 +1,31 @@
+#ifndef LSQECC_MAPPED_FILE_HPP
+#define LSQECC_MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+
+namespace lsqecc {
+
+/**
+ * A file's contents, memory mapped read only where mmap is available and read in at once otherwise
+ */
+class MappedFile
+{
+public:
+    // Throws std::runtime_error if the file can't be opened or mapped
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view contents() const {return contents_;}
+
+private:
+    std::string_view contents_;
+    std::string read_contents_; // Only without mmap
+};
+
+}
+
+#endif //LSQECC_MAPPED_FILE_HPP
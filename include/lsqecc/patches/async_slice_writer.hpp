@@ -0,0 +1,89 @@
+#ifndef LSQECC_ASYNC_SLICE_WRITER_HPP
+#define LSQECC_ASYNC_SLICE_WRITER_HPP
+
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/patches/slice_binary.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lsqecc {
+
+/**
+ * Writes slices out on threads of their own, so that slicing carries on meanwhile. A pushed slice is packed into one of
+ * `capacity` reused entries. Serializer threads take turns at the entries: each unpacks its slices into a slice of its
+ * own and serializes them into the entry's buffer. A sequencer thread then hands the buffers to the writer in the order
+ * the slices were pushed, so the output doesn't depend on how many serializers there are. Only what gets written out of
+ * a slice is kept: its cells and distillation timers.
+ *
+ * Once `capacity` slices are waiting, push blocks until the writer has written one out. To keep all serializers busy,
+ * the capacity should be a few times their number. Both must be at least 1, otherwise std::invalid_argument is thrown.
+ */
+class AsyncSliceWriter
+{
+public:
+    // Called on any of the serializer threads, so it must not change shared state
+    using SliceSerializer = std::function<void(const DenseSlice& slice, size_t repeats, std::string& buffer)>;
+    using SerializedSliceWriter = std::function<void(const std::string& buffer)>;
+
+    AsyncSliceWriter(
+            const Layout& layout,
+            size_t capacity,
+            size_t serializer_count,
+            SliceSerializer serializer,
+            SerializedSliceWriter writer);
+    // Stops the threads. Slices pushed but not yet written out are dropped, so only finish writes out all of them. This
+    // is what an exception leaving the slicer gets: the output stops somewhere before the slice it was thrown at
+    ~AsyncSliceWriter();
+
+    AsyncSliceWriter(const AsyncSliceWriter&) = delete;
+    AsyncSliceWriter& operator=(const AsyncSliceWriter&) = delete;
+
+    // Rethrows what the serializer or writer threw, if either has
+    void push(const DenseSlice& slice, size_t repeats);
+    // Returns once all slices pushed are written out. Rethrows what the serializer or writer threw, if either has
+    void finish();
+
+private:
+    void serialize(size_t serializer_index);
+    void sequence();
+    void stop();
+    void rethrow_error();
+
+    struct Entry
+    {
+        PackedSlice slice;
+        size_t repeats;
+        std::string serialized;
+        bool is_serialized = false;
+    };
+
+    SliceBinaryHeader header_;
+    SliceSerializer serializer_;
+    SerializedSliceWriter writer_;
+
+    // Slice number n is in entry n % capacity from when it is pushed until it is written
+    std::vector<Entry> entries_;
+    size_t pushed_ = 0;
+    size_t written_ = 0;
+
+    std::exception_ptr error_;
+    bool stopping_ = false;
+    std::mutex mutex_;
+    std::condition_variable slice_pushed_;
+    std::condition_variable slice_serialized_;
+    std::condition_variable slice_written_;
+    std::vector<DenseSlice> unpacked_slices_; // One per serializer
+    std::vector<std::thread> serializer_threads_;
+    std::thread sequencer_thread_;
+};
+
+}
+
+
+#endif //LSQECC_ASYNC_SLICE_WRITER_HPP
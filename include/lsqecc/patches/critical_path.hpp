@@ -0,0 +1,66 @@
+#ifndef LSQECC_CRITICAL_PATH_HPP
+#define LSQECC_CRITICAL_PATH_HPP
+
+#include <lsqecc/ls_instructions/ls_instructions.hpp>
+#include <lsqecc/patches/dense_slice.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace lsqecc {
+
+enum class InstructionOrdering {
+    Fifo, CriticalPath, Distillation
+};
+
+// Slices a rotated patch keeps its ancilla busy for
+static constexpr size_t ROTATION_STEPS_TO_CLEAR = 3;
+
+// Extra weight of a magic state request, so that paths with more T gates are favoured when they are equally long
+static constexpr size_t CRITICAL_PATH_T_WEIGHT = 2;
+
+
+// Rough number of slices the instruction takes, including the steps it keeps a region busy for
+size_t estimated_instruction_duration(const LSInstruction& instruction);
+
+// Weight of the instruction on a critical path: its duration, plus CRITICAL_PATH_T_WEIGHT for magic state requests
+size_t critical_path_weight(const LSInstruction& instruction);
+
+/**
+ * For a magic state request, the distance from its patch to the magic state it would likely get: the closest one
+ * already distilled, or else the next one to be. Empty for other instructions.
+ */
+std::optional<size_t> magic_state_distance(const DenseSlice& slice, const MagicStateArrival& next_arrival, const LSInstruction& instruction);
+
+/**
+ * Puts the magic state requests first, those closest to the next magic state ahead, so that each state goes to a
+ * request next to it. The other instructions keep their order after them.
+ */
+template<typename InstructionId, typename InstructionOf>
+void order_by_magic_state_proximity(const DenseSlice& slice, std::vector<InstructionId>& instruction_ids, InstructionOf instruction_of)
+{
+    auto next_arrival = slice.next_magic_state_arrival();
+    if (!next_arrival) return;
+
+    std::unordered_map<InstructionId, size_t> distances;
+    for (InstructionId instruction_id : instruction_ids)
+        if (auto distance = magic_state_distance(slice, *next_arrival, instruction_of(instruction_id)))
+            distances[instruction_id] = *distance;
+    if (distances.empty()) return;
+
+    std::stable_sort(instruction_ids.begin(), instruction_ids.end(), [&distances](InstructionId lhs, InstructionId rhs)
+    {
+        auto lhs_distance = distances.find(lhs);
+        auto rhs_distance = distances.find(rhs);
+        if (lhs_distance != distances.end() && rhs_distance != distances.end())
+            return lhs_distance->second < rhs_distance->second;
+        return lhs_distance != distances.end() && rhs_distance == distances.end();
+    });
+}
+
+}
+
+#endif //LSQECC_CRITICAL_PATH_HPP
@@ -8,6 +8,7 @@
 #include <lsqecc/patches/patch_computation_result.hpp>
 #include <lsqecc/patches/dense_slice.hpp>
 #include <lsqecc/patches/patches.hpp>
+#include <lsqecc/patches/critical_path.hpp>
 #include <lsqecc/layout/layout.hpp>
 #include <lsqecc/layout/router.hpp>
 
@@ -15,15 +16,39 @@
 
 #include <chrono>
 #include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
 
 namespace lsqecc {
 
 enum class PipelineMode {
-    Stream, Dag, Wave
+    Stream, Dag, Wave, Lookahead
+};
+
+/**
+ * Bounds on the instructions held at once by the dag pipeline, which otherwise reads the whole input before slicing.
+ * More instructions are read as executed ones leave the dag.
+ */
+struct DagWindow
+{
+    std::optional<size_t> max_instructions;
+    std::optional<size_t> max_memory_bytes;
+
+    bool has_room(size_t instructions, size_t memory_bytes) const
+    {
+        return (!max_instructions || instructions < *max_instructions)
+            && (!max_memory_bytes || memory_bytes < *max_memory_bytes);
+    }
 };
 
 using DenseSliceVisitor = std::function<void(const DenseSlice& slice)>;
+// Visits `repeats` consecutive slices at once, which differ from `slice` only in their distillation timers
+using DenseSliceRepeatVisitor = std::function<void(const DenseSlice& slice, size_t repeats)>;
 using LSInstructionVisitor = std::function<void(const LSInstruction& slice)>;
+struct WaveStats;
+using WaveStatsVisitor = std::function<void(const WaveStats& wave_stats)>;
 
 struct DensePatchComputationResult : public PatchComputationResult {
     using PatchComputationResult::PatchComputationResult;
@@ -41,25 +66,58 @@ struct DensePatchComputationResult : public PatchComputationResult {
 DensePatchComputationResult run_through_dense_slices(
         LSInstructionStream&& instruction_stream,
         PipelineMode pipeline_mode,
+        DagWindow dag_window,
+        std::optional<size_t> wave_window,
+        size_t lookahead_depth,
         bool local_instructions,
         bool allow_twists,
         const Layout& layout,
         Router& router,
+        InstructionOrdering instruction_ordering,
+        bool pauli_commutation, // Instructions acting on a patch with the same Pauli operator commute
         std::optional<std::chrono::seconds> timeout,
         DenseSliceVisitor slice_visitor,
+        DenseSliceRepeatVisitor slice_repeat_visitor, // If empty, slices spent waiting on distillation are visited one by one
         LSInstructionVisitor instruction_visitor,
-        bool graceful);
+        WaveStatsVisitor wave_stats_visitor, // Only visited with PipelineMode::Wave
+        bool graceful,
+        std::function<void()> on_halt); // With graceful, called when slicing halts on an exception, before it is reported
 
 
 static constexpr size_t MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE = 100;
 
 
 
+/**
+ * What an instruction that failed to apply waits for. Retrying it is pointless until may_proceed holds, which is only
+ * claimed when the blocking resource changed: a distillation completed, a cell cleared or a patch deactivated.
+ */
+struct WaitCondition
+{
+    enum class Reason : uint8_t
+    {
+        Unknown, // Retried on every slice
+        MagicStateUnavailable, // Until a magic state is distilled
+        PatchActive, // Until the patch found at cell is no longer active there
+        CellOccupied, // Until one of cells_to_clear is free, or the patch found at cell has moved
+        RouteBlocked // Retried on every slice, as telling whether a route opened up takes routing again
+    };
+
+    Reason reason = Reason::Unknown;
+    std::optional<Cell> cell;
+    std::optional<PatchId> patch_id; // Of the patch found at cell
+    std::vector<Cell> cells_to_clear;
+
+    bool may_proceed(const DenseSlice& slice) const;
+};
+
+
 // TODO replace with a variant
 struct InstructionApplicationResult
 {
     std::unique_ptr<std::exception> maybe_error;
     std::vector<LSInstruction> followup_instructions;
+    WaitCondition wait_condition;
 };
 
 InstructionApplicationResult try_apply_instruction_direct_followup(
@@ -71,6 +129,67 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         Router& router);
 
 
+/**
+ * Parks instructions that failed to apply, keyed by the pipeline's own handle on them. A parked instruction is only
+ * tried again once its WaitCondition may proceed; until then its last failure is returned without touching the slice.
+ *
+ * Parked instructions are indexed by what they wait for, a magic state or a patch leaving a cell, and wake holds each
+ * cell against all instructions waiting on it at once. Magic states are only distilled between slices, so an
+ * instruction waiting for one is not looked at again until wake finds one. Cells can also be released by instructions
+ * applied during the slice, so once try_apply has applied anything, cell conditions are checked again when asked.
+ */
+class ParkedInstructions
+{
+public:
+    // Call once per slice, after whatever changed the slice other than try_apply and before trying parked instructions
+    void wake(const DenseSlice& slice);
+
+    // Whether the instruction is parked and what it waits for has not changed on the slice
+    bool waiting(size_t key, const DenseSlice& slice) const;
+    // Same, but only if what it waits for is a magic state
+    bool waiting_on_magic_state(size_t key, const DenseSlice& slice) const;
+
+    InstructionApplicationResult try_apply(
+            size_t key,
+            DenseSlice& slice,
+            LSInstruction& instruction,
+            bool local_instructions,
+            bool allow_twists,
+            const Layout& layout,
+            Router& router);
+
+private:
+    struct ParkedInstruction
+    {
+        std::string error;
+        WaitCondition wait_condition;
+        size_t parking; // Tells index entries left over from an earlier parking of the same key apart
+        bool woken = false;
+    };
+
+    // One of the cells a parked instruction waits on
+    struct CellWaiter
+    {
+        size_t key;
+        size_t parking;
+        WaitCondition::Reason reason;
+        std::optional<PatchId> patch_id;
+        bool until_free; // One of cells_to_clear, rather than the cell the patch with patch_id is found at
+
+        bool released(const std::optional<DensePatch>& patch) const;
+    };
+
+    void index(size_t key, ParkedInstruction& parked_instruction);
+    bool may_proceed(const ParkedInstruction& parked_instruction, const DenseSlice& slice) const;
+
+    std::unordered_map<size_t, ParkedInstruction> parked_;
+    std::vector<std::pair<size_t, size_t>> magic_state_waiters_; // key and parking
+    std::map<Cell, std::vector<CellWaiter>> cell_waiters_;
+    size_t parkings_ = 0;
+    bool slice_changed_ = true; // By try_apply since the last wake
+};
+
+
 }
 
 
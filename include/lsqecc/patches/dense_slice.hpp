@@ -15,6 +15,13 @@ namespace lsqecc
 
 
 
+// Where and in how many steps the next magic state becomes available, no steps if one already is
+struct MagicStateArrival
+{
+    SurfaceCodeTimestep steps;
+    Cell cell;
+};
+
 struct DenseSlice : public Slice
 {
     using Slice::Slice;
@@ -62,6 +69,9 @@ struct DenseSlice : public Slice
     std::vector<Cell> get_neigbours_within_slice(const Cell& cell) const override;
 
     SurfaceCodeTimestep time_to_next_magic_state(size_t distillation_region_id) const override;
+
+    // From the distillation timers, the next magic state to become available
+    std::optional<MagicStateArrival> next_magic_state_arrival() const;
 };
 
 }
@@ -0,0 +1,83 @@
+#ifndef LSQECC_SLICE_BINARY_HPP
+#define LSQECC_SLICE_BINARY_HPP
+
+#include <lsqecc/patches/dense_slice.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lsqecc {
+
+/**
+ * A binary format for dense slices, far smaller than their JSON. Everything is little endian:
+ *
+ *   header: "LSQSLICE", u32 version, u32 flags, u32 rows, u32 columns, u32 distillation region count, then for each
+ *           region the u32 row and column of the cell its timer is shown on
+ *   slice:  with the repeat counts flag, a u32 count of how many times in a row the slice's cells were the same,
+ *           then a u64 per cell, row major, then a u32 time to next magic state per distillation region
+ *
+ * Version 1 has no flags field. Every slice takes the same number of bytes, so slice n can be found by its offset, e.g.
+ * in a memory mapped file. An empty cell's word is 0, otherwise:
+ *
+ *   bit 0       set
+ *   bits 1-3    PatchType
+ *   bits 4-6    PatchActivity
+ *   bits 7-22   the top, bottom, left and right boundaries, 4 bits each: BoundaryType, then is_active
+ *   bit 23      set when the patch has an id
+ *   bits 32-63  the id
+ *
+ * Patch labels are not kept.
+ */
+
+constexpr uint32_t k_slice_binary_version = 2;
+
+struct SliceBinaryHeader
+{
+    Cell furthest_cell;
+    std::vector<Cell> timer_cells; // One per distillation region, in the layout's order
+    bool repeat_counts = false;
+
+    size_t cell_count() const;
+    size_t slice_size() const; // In bytes
+};
+
+SliceBinaryHeader slice_binary_header(const Layout& layout);
+
+void write_slice_binary_header(const SliceBinaryHeader& header, std::string& buffer);
+// Appends the slice to the buffer. Repeats are only written with the header's repeat_counts
+void write_slice_binary(const SliceBinaryHeader& header, const DenseSlice& slice, std::string& buffer, uint32_t repeats = 1);
+
+uint64_t encode_slice_binary_cell(const std::optional<DensePatch>& patch);
+std::optional<DensePatch> decode_slice_binary_cell(uint64_t word);
+
+// All of a slice that gets written out: its cells, encoded as above and row major, and its distillation timers
+struct PackedSlice
+{
+    std::vector<uint64_t> cells;
+    std::vector<SurfaceCodeTimestep> timers;
+};
+
+// Reuses the packed slice's storage
+void pack_slice(const SliceBinaryHeader& header, const DenseSlice& slice, PackedSlice& packed);
+// Sets the cells and distillation timers of a slice on the same layout
+void unpack_slice(const PackedSlice& packed, DenseSlice& slice);
+
+// Throws std::runtime_error if the stream doesn't start with a header of this or an earlier version
+SliceBinaryHeader read_slice_binary_header(std::istream& is);
+
+// Reads the next slice's cells, row major, distillation timers and repeat count, 1 without the header's repeat_counts.
+// Returns false at the end of the stream and throws std::runtime_error if it ends part way through a slice
+bool read_slice_binary(
+        std::istream& is,
+        const SliceBinaryHeader& header,
+        std::vector<std::optional<DensePatch>>& cells,
+        std::vector<SurfaceCodeTimestep>& timers,
+        uint32_t& repeats);
+
+}
+
+
+#endif //LSQECC_SLICE_BINARY_HPP
@@ -0,0 +1,40 @@
+#ifndef LSQECC_SLICE_RUNS_HPP
+#define LSQECC_SLICE_RUNS_HPP
+
+#include <lsqecc/patches/dense_slice.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace lsqecc {
+
+/**
+ * Holds back each slice until one with different cells comes, so that a run of slices with the same cells can be
+ * written out once, with how many slices it lasted. Cells are compared by their slice_binary encoding, which has all of
+ * a cell that gets written out. Distillation timers are not compared, a run is written with its first slice's.
+ */
+class SliceRunCollapser
+{
+public:
+    using RunWriter = std::function<void(const DenseSlice& slice, size_t repeats)>;
+
+    explicit SliceRunCollapser(RunWriter run_writer);
+
+    void visit(const DenseSlice& slice);
+    // Writes out the run held back, if any
+    void flush();
+
+private:
+    RunWriter run_writer_;
+    std::optional<DenseSlice> run_slice_;
+    size_t run_length_ = 0;
+    std::vector<uint64_t> run_cells_;
+    std::vector<uint64_t> cells_;
+};
+
+}
+
+
+#endif //LSQECC_SLICE_RUNS_HPP
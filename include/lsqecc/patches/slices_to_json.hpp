@@ -5,6 +5,10 @@
 #include <lsqecc/patches/sparse_slice.hpp>
 #include <nlohmann/json.hpp>
 
+#include <optional>
+#include <string>
+#include <vector>
+
 namespace lsqecc {
 
 
@@ -27,6 +31,37 @@ nlohmann::json slices_to_json(const std::vector<SliceType>& slices)
 }
 
 
+/**
+ * Writes dense slices in the schema of slice_to_json without building a json tree for them. Indented output is byte
+ * for byte what slice_to_json(slice).dump(3) gives, compact output has no whitespace at all, like dump().
+ */
+class SliceJsonWriter
+{
+public:
+    SliceJsonWriter(const Layout& layout, bool compact);
+    // For slices without their layout at hand. Each distillation region's timer is shown on its cell in timer_cells
+    SliceJsonWriter(Cell furthest_cell, const std::vector<Cell>& timer_cells, bool compact);
+
+    // Appends the slice to the buffer. A slice repeated more than once is written as {"repeat": repeats, "slice": slice}
+    void write(const DenseSlice& slice, std::string& buffer, size_t repeats = 1) const;
+    // Same, for a slice given as its cells, row major, and the time to the next magic state of each distillation region
+    void write(
+            const std::vector<std::optional<DensePatch>>& cells,
+            const std::vector<SurfaceCodeTimestep>& timers,
+            std::string& buffer,
+            size_t repeats = 1) const;
+
+private:
+    template<class CellAt, class TimerOf>
+    void write_cells(std::string& buffer, size_t repeats, CellAt cell_at, TimerOf time_to_next_magic_state) const;
+
+    bool compact_;
+    Cell furthest_cell_;
+    // For each cell, row major, the distillation region whose timer is shown on it
+    std::vector<std::optional<size_t>> timer_region_at_;
+};
+
+
 }
 
 
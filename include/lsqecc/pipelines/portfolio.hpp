@@ -0,0 +1,54 @@
+#ifndef LSQECC_PORTFOLIO_HPP
+#define LSQECC_PORTFOLIO_HPP
+
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lsqecc {
+
+// A configuration the portfolio slices the input with
+struct PortfolioCandidate
+{
+    std::string pipeline;
+    std::optional<std::string> graph_search; // The slicer's default when not given
+
+    std::string name() const;
+};
+
+// Parses a comma separated list of pipeline[:graph search], e.g. "stream,dag:astar,wave:astar". Throws
+// std::invalid_argument for unknown pipelines or graph searches. An empty list gives the stream and dag pipelines with
+// each of djikstra and astar, and the wave pipeline, which always routes with A*
+std::vector<PortfolioCandidate> parse_portfolio_candidates(std::string_view candidates);
+
+struct PortfolioOptions
+{
+    std::vector<PortfolioCandidate> candidates;
+    std::optional<std::chrono::seconds> budget; // After which candidates still slicing are stopped
+    std::optional<std::string> input_file; // Otherwise read from the input stream
+    std::optional<std::string> output_file; // Given with -o. Candidates write to memory instead
+};
+
+/**
+ * Slices the input with each candidate on a thread of its own and writes out only the result with the fewest slices,
+ * the first candidate in the list winning ties. The input is read once and every candidate buffers its output.
+ *
+ * Once a candidate has finished, the others are stopped as soon as they can no longer beat it. Without a budget, the
+ * result is the same as if every candidate ran to completion.
+ *
+ * argv is the slicer's command line. Every candidate runs it with its own -P and -g, and without -i.
+ */
+int run_portfolio(
+        int argc, const char* argv[],
+        const PortfolioOptions& options,
+        std::istream& in_stream,
+        std::ostream& out_stream,
+        std::ostream& err_stream);
+
+}
+
+
+#endif //LSQECC_PORTFOLIO_HPP
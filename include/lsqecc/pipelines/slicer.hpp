@@ -1,6 +1,7 @@
 #ifndef LSQECC_SLICER_HPP
 #define LSQECC_SLICER_HPP
 
+#include <functional>
 #include <iostream>
 
 namespace lsqecc {
@@ -12,6 +13,21 @@ int run_slicer_program(
         std::ostream& err_stream);
 
 
+// Lets the caller follow a run of the slicer, as the portfolio does for its candidates
+struct SlicerHooks
+{
+    std::ostream* bulk_output_stream = nullptr; // Written to instead of the file given with -o
+    std::function<void(size_t slice_count)> on_slice; // Called with the number of slices so far. May throw to stop slicing
+};
+
+int run_slicer_program(
+        int argc, const char* argv[],
+        std::istream& in_stream,
+        std::ostream& out_stream,
+        std::ostream& err_stream,
+        const SlicerHooks& hooks);
+
+
 
 std::string run_slicer_program_from_strings(std::string command_line, std::string standard_input);
 
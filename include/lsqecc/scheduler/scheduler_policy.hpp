@@ -0,0 +1,149 @@
+#ifndef LSQECC_SCHEDULER_POLICY_HPP
+#define LSQECC_SCHEDULER_POLICY_HPP
+
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lsqecc/dag/domain_dags.hpp>
+#include <lsqecc/layout/layout.hpp>
+#include <lsqecc/layout/router.hpp>
+#include <lsqecc/ls_instructions/ls_instructions.hpp>
+#include <lsqecc/ls_instructions/ls_instruction_stream.hpp>
+#include <lsqecc/patches/critical_path.hpp>
+#include <lsqecc/patches/dense_patch_computation.hpp>
+
+namespace lsqecc {
+
+// Number of ready instructions the lookahead policy evaluates before committing any of them to a slice
+static constexpr size_t DEFAULT_SCHEDULER_LOOKAHEAD_DEPTH = 8;
+
+enum class SliceOutcome {
+    Complete, // The slice is done, it is visited, advanced and counted
+    Blocked, // An instruction failed to apply. The slice is visited and advanced, but not counted
+    Drained // The policy ran out of instructions. The slice is visited as it is and slicing stops
+};
+
+/**
+ * Decides which instructions go on each slice. The slicing core asks for slices until the policy is done, and takes care
+ * of visiting and advancing them, so that scheduling strategies can be swapped without touching it.
+ */
+class SchedulerPolicy
+{
+public:
+    virtual ~SchedulerPolicy() = default;
+
+    virtual bool done() const = 0;
+    virtual SliceOutcome schedule_slice(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res) = 0;
+
+    // If nothing but waiting for a magic state would happen on the next `slices` slices, the outcome each of them would
+    // have. The slicing core may then skip over them, calling skip_idle_slices instead of scheduling them one by one
+    virtual std::optional<SliceOutcome> idle_outcome(const DenseSlice& slice, size_t slices) const
+    {
+        LSTK_UNUSED(slice); LSTK_UNUSED(slices);
+        return std::nullopt;
+    }
+    virtual void skip_idle_slices(size_t slices) { LSTK_UNUSED(slices); }
+};
+
+
+/**
+ * Applies instructions in input order, starting a new slice whenever one has followups or fails to apply. A failed
+ * instruction holds up the ones behind it until it applies.
+ */
+class StreamSchedulerPolicy : public SchedulerPolicy
+{
+public:
+    StreamSchedulerPolicy(LSInstructionStream&& stream, bool local_instructions, bool allow_twists, const Layout& layout, Router& router);
+
+    bool done() const override { return drained_; }
+    SliceOutcome schedule_slice(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res) override;
+    std::optional<SliceOutcome> idle_outcome(const DenseSlice& slice, size_t slices) const override;
+    void skip_idle_slices(size_t slices) override;
+
+private:
+    LSInstructionStream& stream_;
+    bool local_instructions_;
+    bool allow_twists_;
+    const Layout& layout_;
+    Router& router_;
+    ParkedInstructions parked_instructions_;
+
+    std::deque<LSInstruction> future_instructions_;
+    // Out of retries; thrown once the slice it failed on has been visited
+    std::optional<std::string> fatal_error_;
+    bool drained_ = false;
+};
+
+
+/**
+ * Tracks dependencies between instructions in a dag, so that any instruction whose dependencies are done can be applied.
+ * Proximate instructions, the followups of those applied on the previous slice, go first, then the other ready ones.
+ */
+class DagSchedulerPolicy : public SchedulerPolicy
+{
+public:
+    DagSchedulerPolicy(LSInstructionStream&& stream, DagWindow dag_window, bool local_instructions, bool allow_twists, const Layout& layout, Router& router, InstructionOrdering instruction_ordering, bool pauli_commutation);
+
+    bool done() const override { return dag_.empty(); }
+    SliceOutcome schedule_slice(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res) override;
+    std::optional<SliceOutcome> idle_outcome(const DenseSlice& slice, size_t slices) const override;
+    void skip_idle_slices(size_t slices) override;
+
+protected:
+    // Puts the ready, non-proximate instructions in the order they are tried on the slice
+    virtual void order_ready_instructions(const DenseSlice& slice, std::vector<dag::label_t>& ready_instructions);
+
+    bool local_instructions_;
+    bool allow_twists_;
+    const Layout& layout_;
+    Router& router_;
+    ParkedInstructions parked_instructions_;
+
+    dag::IncrementalDependencyDagBuilder<LSInstruction> dag_builder_;
+    dag::DependencyDag<LSInstruction>& dag_;
+
+private:
+    void fill_window();
+    void handle_followup_instructions(dag::label_t instruction_label, std::vector<LSInstruction>&& followup_instructions);
+
+    LSInstructionStream& stream_;
+    DagWindow dag_window_;
+    InstructionOrdering instruction_ordering_;
+    // Remaining critical path of each instruction, only kept with InstructionOrdering::CriticalPath
+    std::unordered_map<dag::label_t, size_t> priorities_;
+    std::unordered_map<dag::label_t, size_t> attempts_per_instruction_;
+    // Waiting on distillation is not counted as a retry, so instead this many slices in a row may go by with
+    // instructions waiting on a magic state and none to be had, in case one is never distilled
+    size_t max_slices_without_magic_state_;
+    size_t slices_without_magic_state_ = 0;
+};
+
+
+/**
+ * Greedy variant of the dag policy. Before committing anything to a slice, the first few ready instructions are tried
+ * on a scratch copy of it, to see how many cells each would claim. Those that fit go first, cheapest first, so that
+ * more of them share the slice; those that would not fit go last.
+ */
+class LookaheadSchedulerPolicy : public DagSchedulerPolicy
+{
+public:
+    LookaheadSchedulerPolicy(LSInstructionStream&& stream, DagWindow dag_window, size_t depth, bool local_instructions, bool allow_twists, const Layout& layout, Router& router, InstructionOrdering instruction_ordering, bool pauli_commutation);
+
+protected:
+    void order_ready_instructions(const DenseSlice& slice, std::vector<dag::label_t>& ready_instructions) override;
+
+private:
+    // Number of cells the instruction would claim on the slice, if it can be applied there at all
+    std::optional<size_t> routing_demand(const DenseSlice& slice, dag::label_t instruction_label);
+
+    size_t depth_;
+};
+
+}
+
+
+#endif //LSQECC_SCHEDULER_POLICY_HPP
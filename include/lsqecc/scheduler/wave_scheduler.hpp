@@ -2,7 +2,15 @@
 #define LSQECC_WAVE_SCHEDULER
 
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <unordered_map>
 #include <vector>
 
 #include <lstk/lstk.hpp>
@@ -11,7 +19,9 @@
 #include <lsqecc/layout/router.hpp>
 #include <lsqecc/ls_instructions/ls_instructions.hpp>
 #include <lsqecc/ls_instructions/ls_instruction_stream.hpp>
+#include <lsqecc/patches/critical_path.hpp>
 #include <lsqecc/patches/dense_patch_computation.hpp>
+#include <lsqecc/scheduler/scheduler_policy.hpp>
 
 namespace lsqecc {
 
@@ -19,25 +29,92 @@ struct WaveStats
 {
 	size_t wave_size; // number of instructions in wave
 	size_t applied_wave_size; // number of instructions in wave that were actually applied
+	size_t proximate_heads = 0; // followups continuing on this wave
+	size_t ready_heads = 0; // instructions whose dependencies are done
+	size_t retried = 0; // heads that failed to apply and wait for the next wave
+	size_t rescheduled_self = 0; // instructions that applied and continue on the next wave
+	size_t magic_states_consumed = 0;
+	
+	// Only measured when the stats are visited, as they take a pass over the slice and the clock
+	std::ptrdiff_t routing_cells_change = 0; // routing cells on the slice after the wave less those before it
+	std::chrono::microseconds routing_time{0}; // spent finding routes
+	std::chrono::microseconds wave_time{0}; // spent scheduling the whole wave
+	
+	size_t repeats = 1; // number of identical waves these stats stand for, when waiting on distillation
 };
 
-class WaveScheduler
+std::ostream& print_wave_stats_csv_header(std::ostream& os);
+std::ostream& print_wave_stats_csv(std::ostream& os, size_t wave_index, const WaveStats& wave_stats);
+
+/**
+ * Schedules instructions in waves, one per slice. Instructions are read from the stream as they are needed: all at
+ * once by default, or, given a window, only while fewer than that many records are waiting to complete. Records of
+ * completed instructions are reused, so that memory is bounded by the window rather than by the length of the input.
+ */
+class WaveScheduler : public SchedulerPolicy
 {
 public:
 	
-	WaveScheduler(LSInstructionStream&& stream, bool local_instructions, bool allow_twists, const Layout& layout);
+	WaveScheduler(LSInstructionStream&& stream, std::optional<size_t> window, bool local_instructions, bool allow_twists, const Layout& layout, LocalRoutingMode local_routing_mode, InstructionOrdering instruction_ordering, bool pauli_commutation, WaveStatsVisitor wave_stats_visitor = {});
 	
-	bool done() const { return current_wave_.proximate_heads_.empty() && current_wave_.heads.empty(); }
+	bool done() const override { return current_wave_.proximate_heads_.empty() && current_wave_.heads.empty() && !stream_.has_next_instruction(); }
 	WaveStats schedule_wave(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res);
+	SliceOutcome schedule_slice(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res) override;
+	std::optional<SliceOutcome> idle_outcome(const DenseSlice& slice, size_t slices) const override;
+	void skip_idle_slices(size_t slices) override;
 	
 private:
 	
 	using InstructionID = uint32_t;
+	static constexpr InstructionID NO_INSTRUCTION = UINT32_MAX;
+	
+	// Most instructions have a dependent per patch at most, so a few are kept inline and only longer lists allocate
+	class DependentList
+	{
+	public:
+		size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		
+		InstructionID operator[](size_t i) const { return i < INLINE_CAPACITY ? inline_[i] : (*overflow_)[i-INLINE_CAPACITY]; }
+		
+		void push_back(InstructionID instruction_id)
+		{
+			if (size_ < INLINE_CAPACITY)
+				inline_[size_] = instruction_id;
+			else
+			{
+				if (!overflow_) overflow_ = std::make_unique<std::vector<InstructionID>>();
+				overflow_->push_back(instruction_id);
+			}
+			++size_;
+		}
+		
+		// Keeps the overflow allocation for the next instruction that uses the record
+		void clear()
+		{
+			size_ = 0;
+			if (overflow_) overflow_->clear();
+		}
+		
+	private:
+		static constexpr size_t INLINE_CAPACITY = 3;
+		
+		std::array<InstructionID, INLINE_CAPACITY> inline_;
+		uint32_t size_ = 0;
+		std::unique_ptr<std::vector<InstructionID>> overflow_;
+	};
 	
 	struct InstructionRecord
 	{
 		LSInstruction instruction;
-		std::vector<InstructionID> dependents;
+		DependentList dependents;
+		
+		// Followups don't have dependents of their own. Instead they report to the record they were expanded from,
+		// which completes once all of its followups have
+		InstructionID parent = NO_INSTRUCTION;
+		uint32_t pending_followups = 0;
+		
+		bool live = true;
 	};
 
 	struct Wave
@@ -56,18 +133,52 @@ private:
 	
 	// returns number of instruction_ids that were applied
 	size_t schedule_instructions(const std::vector<InstructionID>& instruction_ids, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res, bool proximate);
-	void schedule_dependent_instructions(InstructionID instruction_id, const std::vector<LSInstruction>& followup_instructions, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res);
+	// Sends an applied instruction on to the next wave if it rescheduled itself, otherwise on to its followups
+	void handle_applied_instruction(InstructionID instruction_id, std::vector<LSInstruction>&& followup_instructions, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res);
+	void schedule_dependent_instructions(InstructionID instruction_id, std::vector<LSInstruction>&& followup_instructions, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res);
+	void complete_instruction(InstructionID instruction_id, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res);
+	
+	// returns number of instructions read from the stream
+	size_t ingest_instructions();
+	InstructionID allocate_record(LSInstruction&& instruction, InstructionID parent);
+	void release_record(InstructionID instruction_id);
 	
 	bool is_immediate(const LSInstruction& instruction);
+	void compute_priorities();
+	size_t priority(InstructionID instruction_id) const;
 	bool try_schedule_immediately(InstructionID instruction_id, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res);
 	
 	bool local_instructions_;
 	bool allow_twists_;
 	const Layout& layout_;
 	CustomDPRouter router_;
+	TimedRouter timed_router_{router_}; // what instructions are routed with, so that routing time can be told apart
+	InstructionOrdering instruction_ordering_;
+	dag::ResourceAccessTrait<LSInstruction> patch_access_; // which patches an instruction waits on, and how
+	ParkedInstructions parked_instructions_; // heads that failed to apply, until what they wait for changes
+	WaveStatsVisitor wave_stats_visitor_;
+	WaveStats wave_stats_; // of the wave being scheduled
+	
+	LSInstructionStream& stream_;
+	std::optional<size_t> window_;
+	
+	// The pending instructions later instructions on a patch wait for: the last one acting on it exclusively, or the
+	// last group sharing it that was followed by sharing in another group. See dag::IncrementalDependencyDagBuilder
+	struct PatchFrontier
+	{
+		std::vector<InstructionID> barrier;
+		std::vector<InstructionID> shared_since_barrier;
+		size_t share_group = 0;
+	};
+	std::unordered_map<PatchId, PatchFrontier> patch_frontiers_;
 	
-	std::vector<InstructionRecord> records_;
-	std::vector<uint8_t> dependency_counts_;
+	// Records live in fixed chunks, so that growing the pool neither moves them nor invalidates references into it.
+	// Completed records go to free_records_ and are reused
+	std::deque<InstructionRecord> records_;
+	std::vector<uint32_t> dependency_counts_; // groups sharing a patch can be depended on all at once
+	std::vector<InstructionID> free_records_;
+	size_t live_records_ = 0;
+	std::vector<size_t> priorities_; // remaining critical path, only kept with InstructionOrdering::CriticalPath
 	
 	Wave current_wave_, next_wave_;
 };
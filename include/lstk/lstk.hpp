@@ -101,6 +101,39 @@ static inline std::vector<std::string_view> split_on(std::string_view s, char de
     return ret;
 }
 
+/**
+ * Gives the same pieces as split_on(s, delim), one at a time and without allocating
+ */
+class Splitter
+{
+public:
+    Splitter(std::string_view s, char delim) : rest_(s), delim_(delim), done_(s.empty()) {}
+
+    bool has_next() const {return !done_;}
+
+    std::string_view next()
+    {
+        if(done_)
+            throw std::out_of_range{"Splitter: no pieces left"};
+
+        size_t delim_pos = rest_.find(delim_);
+        if(delim_pos == std::string_view::npos)
+        {
+            done_ = true;
+            return rest_;
+        }
+        // After a trailing delimiter rest_ is empty, but not done, so that the last piece is an empty one
+        std::string_view piece = rest_.substr(0, delim_pos);
+        rest_.remove_prefix(delim_pos+1);
+        return piece;
+    }
+
+private:
+    std::string_view rest_;
+    char delim_;
+    bool done_;
+};
+
 static inline std::vector<std::string_view> split_on(std::string_view s, std::string_view delim)
 {
     std::vector<std::string_view> ret;
@@ -0,0 +1,8 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1,2,3,4,5,6
+BellPairInit 200 201 0:X,1:X
+Init 100 +
+RotateSingleCellPatch 100
+"
+echo "$INPUT" | lsqecc_slicer -l ../examples/core4by4layout.txt --nostagger --printlli sliced --local --localrouting parity
+echo "$INPUT" | lsqecc_slicer -l ../examples/core4by4layout.txt --localrouting parity 2>&1
@@ -0,0 +1,7 @@
+BellPairInit 200 201 0:X,1:X [BellPrepare (1,3),(0,3);BellPrepare (0,2),(0,1);BellPrepare (0,0),(1,0)];
+BellPairInit 200 201 0:X,1:X [BellMeasure (0,3),(0,2);BellMeasure (0,1),(0,0)];Init 100 |+>;RotateSingleCellPatch 100;
+BusyRegion (2,5),(2,6),StepsToClear(2);
+BusyRegion (2,5),(2,6),StepsToClear(1);
+BusyRegion (2,5),(2,6),StepsToClear(0);
+
+--localrouting requires --local
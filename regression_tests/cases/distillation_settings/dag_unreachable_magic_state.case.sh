@@ -0,0 +1,19 @@
+INPUT="
+OPENQASM 2.0;
+include "qelib1.inc";
+
+qreg q[2];
+
+t q[0];
+"
+# The distillation region has no routing cell next to it to put its magic states on, so none is ever distilled.
+# Waiting on one must still give up
+LAYOUT="
+rrrQ1
+QrrQQ
+"
+
+echo "$LAYOUT" > tmp.layout
+echo "$INPUT" | lsqecc_slicer -q -l tmp.layout -P dag --graceful --noslices 2>&1 | grep -v "Took"
+echo "$INPUT" | lsqecc_slicer -q -l tmp.layout -P lookahead --graceful --noslices 2>&1 | grep -v "Took"
+rm tmp.layout
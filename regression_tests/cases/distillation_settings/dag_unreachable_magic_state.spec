@@ -0,0 +1,10 @@
+Encountered exception: Could not get a magic state for 1000 slices in a row, waiting on:
+RequestMagicState 2 0
+Halting slicing
+LS Instructions read  0
+Slices 1001
+Encountered exception: Could not get a magic state for 1000 slices in a row, waiting on:
+RequestMagicState 2 0
+Halting slicing
+LS Instructions read  0
+Slices 1001
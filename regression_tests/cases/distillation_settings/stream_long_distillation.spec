@@ -0,0 +1,130 @@
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+RequestMagicState 2 1;MultiBodyMeasure 1:Z,2:Z;MeasureSinglePatch 2 X;
+SGate 1;
+ZGate 1;HGate 1;RequestMagicState 3 1;
+MultiBodyMeasure 1:Z,3:Z;MeasureSinglePatch 3 X;
+SGate 1;
+ZGate 1;HGate 1;RequestMagicState 4 1;
+MultiBodyMeasure 1:Z,4:Z;MeasureSinglePatch 4 X;
+SGate 1;
+ZGate 1;
+
@@ -5,10 +5,20 @@ Options:
     -l, --layout           File name of file with layout spec, otherwise the layout is auto-generated (configure with -L)
     -o, --output           File name of output. When not provided outputs to stdout
     -f, --output-format    Requires -o, STDOUT output format: progress, noprogress, machine, stats
+    --sliceformat          Format the slices are written out in: json (default), binary (fixed size slices, turn into JSON with lsqecc_slice_convert)
     -t, --timeout          Set a timeout in seconds after which stop producing slices
     -r, --router           Set a router: graph_search (default), graph_search_cached
-    -P, --pipeline         pipeline mode: stream (default), dag
+    -P, --pipeline         pipeline mode: stream (default), dag, wave, lookahead (dag that packs the cheapest of the next ready instructions first)
+    --dagwindow            Only compatible with -P dag and -P lookahead. Maximum number of pending instructions held in the dependency dag (default: whole input)
+    --dagmemory            Only compatible with -P dag and -P lookahead. Approximate memory cap in MB for the dependency dag (default: unbounded)
+    --wavewindow           Only compatible with -P wave. Maximum number of instructions waiting to complete in the scheduler, more are read as they complete (default: whole input)
+    --wavestats            Only compatible with -P wave. File name to write per-wave scheduler stats to, as CSV
+    --paulicommutation     Only compatible with -P dag, -P wave, -P lookahead and --printdag processedlli. Instructions acting on a common patch with the same Pauli operator, like two Z basis measurements, don't wait for each other
+    --lookaheaddepth       Only compatible with -P lookahead. Number of ready instructions whose routing is evaluated before committing to a slice (default: 8)
+    --portfolio            Slices with several pipeline[:graph search] candidates at once, each on a thread, and outputs the one with the fewest slices. Incompatible with -P, -g, --graceful, --printdag, --printlli before, --wavestats and --mapinput (default: stream:djikstra,stream:astar,dag:djikstra,dag:astar,wave)
+    --portfoliobudget      Only compatible with --portfolio. Seconds after which candidates still slicing are stopped (default: no limit)
     -g, --graph-search     Set a graph search provider: djikstra (default), astar, boost (not always available)
+    --ordering             Only compatible with -P dag, -P wave and -P lookahead. Order in which ready instructions are tried: fifo (default), criticalpath (longest remaining path first, weighted by duration and T count), distillation (magic state requests first, nearest to the next magic state first)
     --graceful             If there is an error when slicing, print the error and terminate
     --printlli             Output LLI instead of JSONs. options: before (default), sliced (prints lli on the same slice separated by semicolons)
     --printdag             Prints a dependancy dag of the circuit. Modes: input (default), processedlli
@@ -21,8 +31,14 @@ Options:
     --numlanes             Only compatible with -L edpc. Configures number of free lanes for routing.
     --condensed            Only compatible with -L edpc. Packs logical qubits more compactly.
     --explicitfactories    Only compatible with -L edpc. Explicitly specifies factories (otherwise, uses tiles reserved for magic state re-spawn).
+    --asyncoutput          Experimental, has not been seen to pay off yet. Write the slices out on a thread of their own while slicing goes on. Slicing waits when this many slices (at least 1) are waiting to be written out
+    --outputthreads        Requires --asyncoutput. Serialize this many slices at once, each on a thread of its own (default 1). The output is the same as with one
+    --repeatslices         Write a run of slices with the same cells once, with how many slices it lasted (in JSON as {"repeat": n, "slice": ...}). Only the first slice's distillation timers are kept
+    --compactjson          Write the slices' JSON without indentation
+    --mapinput             Requires an LLI file given with -i. Memory map the file and parse the instructions in place, instead of reading it line by line
     --nostagger            Turns off staggered distillation block timing
     --disttime             Set the distillation time (default 10)
     --local                Compile gates using a local lattice surgery instruction set
+    --localrouting         Only compatible with --local. Route choice for Bell based instructions: shortest (default), parity (fewest local instruction steps, allows detours)
     --notwists             Compile S gates using twist-based Y state initialization (Gidney, 2024)
     -h, --help             Shows this page        
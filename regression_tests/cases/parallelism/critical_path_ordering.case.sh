@@ -0,0 +1,15 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1
+RotateSingleCellPatch 0
+RotateSingleCellPatch 1
+RotateSingleCellPatch 1
+"
+
+LAYOUT="
+QrQ
+"
+
+echo "$LAYOUT" > tmp.layout
+echo "$INPUT" | lsqecc_slicer -l tmp.layout --printlli sliced -P wave --ordering criticalpath
+echo "$INPUT" | lsqecc_slicer -l tmp.layout --printlli sliced --ordering criticalpath 2>&1
+rm tmp.layout
@@ -0,0 +1,12 @@
+RotateSingleCellPatch 1;
+BusyRegion (0,2),(0,1),StepsToClear(2);
+BusyRegion (0,2),(0,1),StepsToClear(1);
+BusyRegion (0,2),(0,1),StepsToClear(0);RotateSingleCellPatch 1;
+BusyRegion (0,2),(0,1),StepsToClear(2);
+BusyRegion (0,2),(0,1),StepsToClear(1);
+BusyRegion (0,2),(0,1),StepsToClear(0);RotateSingleCellPatch 0;
+BusyRegion (0,0),(0,1),StepsToClear(2);
+BusyRegion (0,0),(0,1),StepsToClear(1);
+BusyRegion (0,0),(0,1),StepsToClear(0);
+
+--ordering requires -P dag, -P wave or -P lookahead
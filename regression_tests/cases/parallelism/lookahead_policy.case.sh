@@ -0,0 +1,16 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1,2,3
+MultiBodyMeasure 1:Z,2:X
+MultiBodyMeasure 3:X,0:X
+MultiBodyMeasure 3:Z,0:X
+"
+
+LAYOUT="
+rrrrQ
+QQrQr
+rrrrr
+"
+
+echo "$LAYOUT" > tmp.layout
+echo "$INPUT" | lsqecc_slicer -l tmp.layout --printlli sliced -P lookahead
+rm tmp.layout
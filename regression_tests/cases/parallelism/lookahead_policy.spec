@@ -0,0 +1,3 @@
+MultiBodyMeasure 3:X,0:X;
+MultiBodyMeasure 3:Z,0:X;MultiBodyMeasure 1:Z,2:X;
+
@@ -0,0 +1,16 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1,2
+MultiBodyMeasure 0:Z,1:Z
+LogicalPauli 0 Z
+MultiBodyMeasure 0:Z,2:Z
+MultiBodyMeasure 1:X,2:X
+"
+
+LAYOUT="
+QrQrQ
+rrrrr
+"
+
+echo "$LAYOUT" > tmp.layout
+echo "$INPUT" | lsqecc_slicer -l tmp.layout --printlli sliced -P dag --paulicommutation
+rm tmp.layout
@@ -0,0 +1,4 @@
+MultiBodyMeasure 0:Z,1:Z;
+ZGate 0;MultiBodyMeasure 0:Z,2:Z;
+MultiBodyMeasure 1:X,2:X;
+
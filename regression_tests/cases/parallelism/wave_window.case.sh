@@ -0,0 +1,15 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1
+RotateSingleCellPatch 0
+RotateSingleCellPatch 1
+RotateSingleCellPatch 0
+"
+
+LAYOUT="
+rr
+QQ
+"
+
+echo "$LAYOUT" > tmp.layout
+echo "$INPUT" | lsqecc_slicer -l tmp.layout --printlli sliced -P wave --wavewindow 2
+rm tmp.layout
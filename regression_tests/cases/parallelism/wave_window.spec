@@ -0,0 +1,9 @@
+RotateSingleCellPatch 0;RotateSingleCellPatch 1;
+BusyRegion (1,0),(0,0),StepsToClear(2);BusyRegion (1,1),(0,1),StepsToClear(2);
+BusyRegion (1,0),(0,0),StepsToClear(1);BusyRegion (1,1),(0,1),StepsToClear(1);
+BusyRegion (1,0),(0,0),StepsToClear(0);BusyRegion (1,1),(0,1),StepsToClear(0);
+RotateSingleCellPatch 0;
+BusyRegion (1,0),(0,0),StepsToClear(2);
+BusyRegion (1,0),(0,0),StepsToClear(1);
+BusyRegion (1,0),(0,0),StepsToClear(0);
+
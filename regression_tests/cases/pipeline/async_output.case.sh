@@ -0,0 +1,24 @@
+INPUT="
+OPENQASM 2.0;
+include \"qelib1.inc\";
+
+qreg q[3];
+h q[0];
+t q[0];
+cx q[1],q[0];
+t q[2];
+"
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag > sync.json
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --asyncoutput 2 > async.json
+cmp -s sync.json async.json && echo "JSON written asynchronously matches"
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --asyncoutput 4 --outputthreads 3 > async.json
+cmp -s sync.json async.json && echo "JSON serialized on several threads matches"
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --sliceformat binary --repeatslices -o sync.bin > /dev/null
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --sliceformat binary --repeatslices --asyncoutput 1 -o async.bin > /dev/null
+cmp -s sync.bin async.bin && echo "Binary slices written asynchronously match"
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --sliceformat binary --repeatslices --asyncoutput 2 --outputthreads 4 -o async.bin > /dev/null
+cmp -s sync.bin async.bin && echo "Binary slices serialized on several threads match"
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --noslices --asyncoutput 2 2>&1
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --outputthreads 2 2>&1
+echo "$INPUT" | lsqecc_slicer -q -L compact -P dag --asyncoutput 0 2>&1
+rm sync.json async.json sync.bin async.bin
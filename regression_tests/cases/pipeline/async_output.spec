@@ -0,0 +1,7 @@
+JSON written asynchronously matches
+JSON serialized on several threads matches
+Binary slices written asynchronously match
+Binary slices serialized on several threads match
+--asyncoutput requires the slices to be written out
+--outputthreads requires --asyncoutput
+--asyncoutput must be at least 1
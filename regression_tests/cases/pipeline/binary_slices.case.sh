@@ -0,0 +1,14 @@
+INPUT="
+OPENQASM 2.0;
+include \"qelib1.inc\";
+
+qreg q[2];
+h q[0];
+t q[1];
+"
+echo "$INPUT" | lsqecc_slicer -q -L compact --sliceformat binary -o slices.bin > /dev/null
+echo "$INPUT" | lsqecc_slicer -q -L compact > slices.json
+lsqecc_slice_convert -i slices.bin > converted.json
+cmp -s slices.json converted.json && echo "Converted binary slices match the JSON"
+lsqecc_slice_convert -i slices.bin --compactjson
+rm slices.bin slices.json converted.json
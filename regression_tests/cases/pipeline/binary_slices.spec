@@ -0,0 +1,16 @@
+Converted binary slices match the JSON
+[
+[[{"activity":{"activity_type":"Unitary"},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:10"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:9"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:8"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:7"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:6"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:5"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:4"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:3"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:2"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:1"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,{"activity":{"activity_type":"Measurement"},"edges":{"Bottom":"SolidStiched","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 2"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:10"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"AncillaJoin","Left":"None","Right":"AncillaJoin","Top":"None"},"patch_type":"Ancilla","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"AncillaJoin","Right":"AncillaJoin","Top":"None"},"patch_type":"Ancilla","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"AncillaJoin","Right":"AncillaJoin","Top":"None"},"patch_type":"Ancilla","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"AncillaJoin","Right":"None","Top":"AncillaJoin"},"patch_type":"Ancilla","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"SolidStiched"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:9"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":"Unitary"},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 3"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:8"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":"Measurement"},"edges":{"Bottom":"SolidStiched","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 3"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"SolidStiched"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]],
+[[{"activity":{"activity_type":null},"edges":{"Bottom":"Dashed","Left":"Solid","Right":"Solid","Top":"Dashed"},"patch_type":"Qubit","text":"Id: 0"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":"Time to next magic state:7"},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"Solid"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"Solid"},"patch_type":"DistillationQubit","text":""}],[null,null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"None","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}],[{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Dashed","Right":"Dashed","Top":"Solid"},"patch_type":"Qubit","text":"Id: 1"},null,null,null,{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"Solid","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"None","Top":"None"},"patch_type":"DistillationQubit","text":""},{"activity":{"activity_type":null},"edges":{"Bottom":"Solid","Left":"None","Right":"Solid","Top":"None"},"patch_type":"DistillationQubit","text":""}]]]
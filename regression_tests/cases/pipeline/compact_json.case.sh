@@ -0,0 +1,8 @@
+INPUT="
+OPENQASM 2.0;
+include \"qelib1.inc\";
+
+qreg q[2];
+t q[1];
+"
+echo "$INPUT" | lsqecc_slicer -q -L compact --compactjson
@@ -0,0 +1,11 @@
+printf 'DeclareLogicalQubitPatches 0,1,2\nInit 3 |+>\n\nMultiBodyMeasure 0:Z,1:X\nRequestMagicState 4 2\nMultiBodyMeasure 2:Z,4:Z\nMeasureSinglePatch 4 X\nHGate 2\nMeasureSinglePatch 3 X\n' > input.lli
+lsqecc_slicer -i input.lli -L compact -P dag > read.json
+lsqecc_slicer -i input.lli -L compact -P dag --mapinput > mapped.json
+grep -q "Qubit" read.json && cmp -s read.json mapped.json && echo "Slices from a mapped file match"
+printf 'DeclareLogicalQubitPatches 0,1,2\nInit 3 |+> 0:Z\n\nMultiBodyMeasure 0:Z,3:X\nMeasureSinglePatch 3 X\nRequestMagicState 4 1\nHGate 2\nBellPairInit 5 6 0:Z,2:X\n' > input.lli
+lsqecc_slicer -i input.lli --printlli before --mapinput
+printf 'DeclareLogicalQubitPatches 0\nHGate 0\n\nHGate\n' > input.lli
+lsqecc_slicer -i input.lli --mapinput 2>&1 | grep -o "Encountered parsing exception at line [0-9]*"
+lsqecc_slicer --mapinput < input.lli 2>&1
+lsqecc_slicer -i input.lli --mapinput --portfolio 2>&1
+rm input.lli read.json mapped.json
@@ -0,0 +1,10 @@
+Slices from a mapped file match
+Init 3 |+> 0:Z
+MultiBodyMeasure 0:Z,3:X
+MeasureSinglePatch 3 X
+RequestMagicState 4 1
+HGate 2
+BellPairInit 5 6 0:Z,2:X
+Encountered parsing exception at line 4
+--mapinput requires an LLI file given with -i
+--portfolio is incompatible with --graceful, --printdag, --printlli before, --wavestats and --mapinput
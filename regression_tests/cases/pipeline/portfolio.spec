@@ -0,0 +1,4 @@
+SGate 0;SGate 1;
+ZGate 0;ZGate 1;HGate 0;
+HGate 0;
+
@@ -0,0 +1,31 @@
+INPUT="
+OPENQASM 2.0;
+include \"qelib1.inc\";
+
+qreg q[2];
+t q[0];
+t q[0];
+t q[1];
+"
+echo "$INPUT" | lsqecc_slicer -q -L compact --repeatslices --compactjson > slices.json
+echo "$INPUT" | lsqecc_slicer -q -L compact --repeatslices --sliceformat binary -o slices.bin > /dev/null
+lsqecc_slice_convert -i slices.bin --compactjson > converted.json
+cmp -s slices.json converted.json && echo "Converted binary slices match the JSON"
+cat slices.json
+rm slices.bin slices.json converted.json
+
+# The run held back when slicing halts under --graceful comes out before the error
+INPUT="
+OPENQASM 2.0;
+include \"qelib1.inc\";
+
+qreg q[2];
+t q[0];
+"
+LAYOUT="
+rrrQ1
+QrrQQ
+"
+echo "$LAYOUT" > tmp.layout
+echo "$INPUT" | lsqecc_slicer -q -l tmp.layout -P dag --graceful --repeatslices --compactjson 2>&1 | grep -o '"repeat":[0-9]*\|Encountered exception'
+rm tmp.layout
@@ -17,11 +17,8 @@ digraph DirectedGraph {
   1 -> 6;
   2 -> 3;
   2 -> 7;
-  2 -> 8;
-  2 -> 11;
   3 -> 8;
   3 -> 9;
-  3 -> 10;
   8 -> 11;
   9 -> 10;
   10 -> 11;
@@ -0,0 +1,7 @@
+RotateSingleCellPatch 0;
+BusyRegion (1,1),(1,0),StepsToClear(2);BusyRegion (1,1),(1,0),StepsToClear(1);
+BusyRegion (1,1),(1,0),StepsToClear(0);
+RotateSingleCellPatch 2;
+BusyRegion (1,4),(1,3),StepsToClear(2);BusyRegion (1,4),(1,3),StepsToClear(1);
+BusyRegion (1,4),(1,3),StepsToClear(0);
+
@@ -0,0 +1,18 @@
+INPUT="
+OPENQASM 2.0;
+include "qelib1.inc";
+
+qreg q[6];
+
+cx q[0],q[1];
+cx q[0],q[2];
+cx q[4],q[5];
+h q[3];
+"
+
+# The timings change from run to run, so only the other columns are compared, and that less time went to routing than
+# to the whole wave
+echo "$INPUT" | lsqecc_slicer -q -P wave --noslices --wavestats tmp.csv > /dev/null
+cut -d, -f1-10 tmp.csv
+awk -F, 'NR > 1 && $11 > $12 { print "routing_us over wave_us on wave " $1 }' tmp.csv
+rm tmp.csv
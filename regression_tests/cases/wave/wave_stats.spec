@@ -0,0 +1,9 @@
+wave,repeats,wave_size,applied,proximate_heads,ready_heads,retried,rescheduled_self,magic_states_consumed,routing_cells_change
+0,1,3,2,0,3,1,0,0,5
+1,1,3,1,0,3,2,0,0,5
+2,1,3,2,0,3,1,0,0,5
+3,1,2,2,1,1,0,0,0,0
+4,1,2,1,1,1,1,0,0,0
+5,1,2,1,1,1,1,0,0,2
+6,1,1,1,0,1,0,0,0,4
+7,1,1,1,0,1,0,0,0,1
@@ -5,12 +5,47 @@
 
 namespace lsqecc::dag {
 
+namespace {
+
+bool erase_label(std::vector<label_t>& adjacency, label_t label)
+{
+    auto it = std::find(adjacency.begin(), adjacency.end(), label);
+    if(it == adjacency.end())
+        return false;
+    adjacency.erase(it);
+    return true;
+}
+
+} // anonymous namespace
+
+
+const DirectedGraph::Node& DirectedGraph::node_or_fail(label_t label, std::string_view action) const
+{
+    if(!contains(label))
+        throw std::runtime_error(lstk::cat("Cannot ", action, " non-existing node: ", label));
+    return node(label);
+}
+
+DirectedGraph::Node& DirectedGraph::node_or_fail(label_t label, std::string_view action)
+{
+    return const_cast<Node&>(const_cast<const DirectedGraph*>(this)->node_or_fail(label, action));
+}
+
+
 void DirectedGraph::add_node(label_t label)
 {
-    if(!edges_.count(label))
+    if(nodes_.empty())
+        first_label_ = label;
+    for(; label < first_label_; --first_label_)
+        nodes_.emplace_front();
+    if(label >= end_label())
+        nodes_.resize(label-first_label_+1);
+
+    if(!node(label).alive)
     {
-        edges_.insert_or_assign(label, Set<label_t>());
-        back_edges_.insert_or_assign(label, Set<label_t>());
+        node(label).alive = true;
+        node_count_++;
+        ready_nodes_.insert(label);
     }
 }
 
@@ -18,72 +53,78 @@ void DirectedGraph::add_edge(label_t from, label_t to)
 {
     add_node(to);
     add_node(from);
-    edges_.at(from).insert(to);
-    back_edges_.at(to).insert(from);
+
+    auto& successors = node(from).successors;
+    if(std::find(successors.begin(), successors.end(), to) != successors.end())
+        return;
+    successors.push_back(to);
+    edge_count_++;
+    if(node(to).predecessors.empty())
+        ready_nodes_.erase(to);
+    node(to).predecessors.push_back(from);
 }
 
 void DirectedGraph::remove_edge(label_t from, label_t to)
 {
-    if(!edges_.count(from))
-        throw std::runtime_error("Cannot remove edge from non-existing node: " + std::to_string(from));
-
-    if(!edges_.count(to))
-        throw std::runtime_error("Cannot remove edge to non-existing node: " + std::to_string(to));
-
-    edges_.at(from).erase(std::find(edges_.at(from).begin(), edges_.at(from).end(), to));
-    back_edges_.at(to).erase(std::find(back_edges_.at(to).begin(), back_edges_.at(to).end(), from));
+    if(erase_label(node_or_fail(from, "remove edge from").successors, to))
+        edge_count_--;
+    auto& predecessors = node_or_fail(to, "remove edge to").predecessors;
+    erase_label(predecessors, from);
+    if(predecessors.empty())
+        ready_nodes_.insert(to);
 }
 
 void DirectedGraph::remove_node(label_t target)
 {
-    if(!edges_.count(target))
-        throw std::runtime_error("Cannot remove non-existing node: " + std::to_string(target));
+    Node& target_node = node_or_fail(target, "remove");
 
-    for(const auto& to : edges_.at(target))
-        remove_edge(target, to);
+    for(const auto& to : target_node.successors)
+    {
+        erase_label(node(to).predecessors, target);
+        if(node(to).predecessors.empty())
+            ready_nodes_.insert(to);
+    }
 
-    for(const auto& from : back_edges_.at(target))
-        remove_edge(from, target);
+    for(const auto& from : target_node.predecessors)
+        erase_label(node(from).successors, target);
+
+    edge_count_ -= target_node.successors.size() + target_node.predecessors.size();
+
+    // Leave a tombstone, releasing the adjacency storage
+    target_node = Node{};
+    ready_nodes_.erase(target);
+    node_count_--;
 
-    edges_.erase(target);
-    back_edges_.erase(target);
+    // Drop the tombstones before the first node, so that storage follows the live range of labels
+    while(!nodes_.empty() && !nodes_.front().alive)
+    {
+        nodes_.pop_front();
+        first_label_++;
+    }
 }
 
 
 std::vector<label_t> DirectedGraph::successors(label_t label) const
 {
-    if(!edges_.count(label))
-        throw std::runtime_error("Cannot get successors of non-existing node: " + std::to_string(label));
-
-    std::vector<label_t> successors;
-    for(const auto& to : edges_.at(label))
-        successors.push_back(to);
-    return successors;
+    return node_or_fail(label, "get successors of").successors;
 }
 
 
 std::vector<label_t> DirectedGraph::predecessors(label_t label) const
 {
-    if(!edges_.count(label))
-        throw std::runtime_error("Cannot get predecessors of non-existing node: " + std::to_string(label));
-
-    std::vector<label_t> predecessors;
-    for(const auto& from : back_edges_.at(label))
-        predecessors.push_back(from);
-    return predecessors;
+    return node_or_fail(label, "get predecessors of").predecessors;
 }
 
 void DirectedGraph::expand(label_t target, const std::vector<label_t>& replacement)
 {
-    if(!edges_.count(target))
-        throw std::runtime_error("Cannot expand non-existing node: " + std::to_string(target));
+    node_or_fail(target, "expand");
 
     if(replacement.size() < 1)
         throw std::runtime_error("Cannot expand into less than 1 node");
 
     for(const auto& label : replacement)
     {
-        if(edges_.count(label))
+        if(contains(label))
             throw std::runtime_error("Cannot expand into existing node");
     }
 
@@ -92,17 +133,14 @@ void DirectedGraph::expand(label_t target, const std::vector<label_t>& replaceme
     for(std::size_t i = 1; i < replacement.size(); ++i)
         add_edge(replacement.at(i-1), replacement.at((i)));
 
-    Set<label_t> forward_dangling;
-    for(const auto& to : edges_.at(target))
-        forward_dangling.insert(to);
+    // Copies, as the adjacency of the target changes while rewiring
+    Adjacency forward_dangling = node(target).successors;
     for(const auto& to : forward_dangling)
         remove_edge(target, to);
     for(const auto& to : forward_dangling)
         add_edge(replacement.back(), to);
 
-    Set<label_t> backward_dangling;
-    for(const auto& from : back_edges_.at(target))
-        backward_dangling.insert(from);
+    Adjacency backward_dangling = node(target).predecessors;
     for(const auto& from : backward_dangling)
         remove_edge(from, target);
     for(const auto& from : backward_dangling)
@@ -114,20 +152,23 @@ void DirectedGraph::expand(label_t target, const std::vector<label_t>& replaceme
 Set<label_t> DirectedGraph::heads() const
 {
     Set<label_t> heads;
-    for(const auto& [label, neighbors] : edges_)
-    {
-        if(back_edges_.at(label).size() == 0)
-            heads.insert(label);
-    }
+    heads.reserve(ready_nodes_.size());
+    for(label_t label : ready_nodes_)
+        heads.insert(label);
     return heads;
 }
 
+size_t DirectedGraph::in_degree(label_t label) const
+{
+    return node_or_fail(label, "get in-degree of").predecessors.size();
+}
+
 Set<label_t> DirectedGraph::tails() const
 {
     Set<label_t> tails;
-    for(const auto& [label, neighbors] : edges_)
+    for(label_t label = first_label_; label < end_label(); ++label)
     {
-        if(edges_.at(label).size() == 0)
+        if(node(label).alive && node(label).successors.empty())
             tails.insert(label);
     }
     return tails;
@@ -135,20 +176,45 @@ Set<label_t> DirectedGraph::tails() const
 
 bool DirectedGraph::empty() const
 {
-    return edges_.empty();
+    return node_count_ == 0;
 }
 
-
-void DirectedGraph::topological_order_helper(label_t current, Set<label_t>& visited, std::vector<label_t>& order) const
+size_t DirectedGraph::approximate_memory_bytes() const
 {
-    if(visited.count(current)) return;
+    return nodes_.size()*sizeof(Node) + 2*edge_count_*sizeof(label_t) + ready_nodes_.size()*4*sizeof(label_t);
+}
+
 
-    visited.insert(current);
+// Depth first, with an explicit stack so that long dependency chains don't overflow the call stack
+void DirectedGraph::topological_order_helper(label_t start, std::vector<bool>& visited, std::vector<label_t>& order) const
+{
+    if(visited[start-first_label_]) return;
 
-    for(const auto& neighbor : edges_.at(current))
-        topological_order_helper(neighbor, visited, order);
+    // Node and index of the next successor to visit
+    std::vector<std::pair<label_t, size_t>> stack;
+    visited[start-first_label_] = true;
+    stack.emplace_back(start, 0);
 
-    order.push_back(current);
+    while(!stack.empty())
+    {
+        auto& [current, next_successor] = stack.back();
+        const auto& successors = node(current).successors;
+
+        if(next_successor < successors.size())
+        {
+            label_t neighbor = successors[next_successor++];
+            if(!visited[neighbor-first_label_])
+            {
+                visited[neighbor-first_label_] = true;
+                stack.emplace_back(neighbor, 0);
+            }
+        }
+        else
+        {
+            order.push_back(current);
+            stack.pop_back();
+        }
+    }
 }
 
 
@@ -156,13 +222,56 @@ void DirectedGraph::topological_order_helper(label_t current, Set<label_t>& visi
 std::vector<label_t> DirectedGraph::topological_order_tails_first() const
 {
     std::vector<label_t> order;
-    Set<label_t> visited;
-    for(const auto& head : heads())
+    std::vector<bool> visited(nodes_.size(), false);
+    for(const auto& head : ready_nodes_)
         topological_order_helper(head, visited, order);
     return order;
 }
 
 
+TopologicalLevels DirectedGraph::topological_levels() const
+{
+    TopologicalLevels levels;
+    levels.first_label = first_label_;
+    levels.order.reserve(node_count_);
+    levels.asap.assign(nodes_.size(), 0);
+    levels.alap.assign(nodes_.size(), 0);
+
+    std::vector<size_t> remaining_predecessors(nodes_.size(), 0);
+    for(size_t i = 0; i < nodes_.size(); ++i)
+        remaining_predecessors[i] = nodes_[i].predecessors.size();
+
+    // The order doubles as the queue of Kahn's algorithm
+    levels.order.insert(levels.order.end(), ready_nodes_.begin(), ready_nodes_.end());
+    for(size_t i = 0; i < levels.order.size(); ++i)
+    {
+        label_t current = levels.order[i];
+        size_t current_asap = levels.asap[current-first_label_];
+        levels.depth = std::max(levels.depth, current_asap+1);
+        for(label_t successor : node(current).successors)
+        {
+            size_t& successor_asap = levels.asap[successor-first_label_];
+            successor_asap = std::max(successor_asap, current_asap+1);
+            if(--remaining_predecessors[successor-first_label_] == 0)
+                levels.order.push_back(successor);
+        }
+    }
+
+    if(levels.order.size() != node_count_)
+        throw std::runtime_error("Cannot sort a graph with cycles topologically");
+
+    for(auto it = levels.order.rbegin(); it != levels.order.rend(); ++it)
+    {
+        size_t alap = levels.depth-1;
+        for(label_t successor : node(*it).successors)
+            alap = std::min(alap, levels.alap[successor-first_label_]-1);
+        levels.alap[*it-first_label_] = alap;
+    }
+
+    return levels;
+}
+
+
 
 std::ostream& DirectedGraph::to_graphviz(
     std::ostream& os,
@@ -174,8 +283,11 @@ std::ostream& DirectedGraph::to_graphviz(
     os << "digraph DirectedGraph {" << std::endl;
 
     // Print all nodes
-    for(const auto& [label, neighbors] : edges_)
+    for(label_t label = first_label_; label < end_label(); ++label)
     {
+        if(!node(label).alive)
+            continue;
+
         if(nodes_contents.contains(label))
             os << "  "<<label << " [shape=\"plaintext\","
                << "label=<"
@@ -189,8 +301,8 @@ std::ostream& DirectedGraph::to_graphviz(
     }
 
     // Print all edges
-    for(const auto& [from, neighbors] : edges_)
-        for(const auto& to : neighbors)
+    for(label_t from = first_label_; from < end_label(); ++from)
+        for(const auto& to : node(from).successors)
             os << "  " << from << " -> " << to << ";" << std::endl;
 
     if(extra_content)
@@ -201,15 +313,23 @@ std::ostream& DirectedGraph::to_graphviz(
 }
 
 
-const Map<label_t, Set<label_t>>& get_edges_for_testing(const DirectedGraph& g)
+Map<label_t, Set<label_t>> get_edges_for_testing(const DirectedGraph& g)
 {
-    return g.edges_;
+    Map<label_t, Set<label_t>> edges;
+    for(label_t label = g.first_label_; label < g.end_label(); ++label)
+        if(g.node(label).alive)
+            edges[label].insert(g.node(label).successors.begin(), g.node(label).successors.end());
+    return edges;
 }
 
-const Map<label_t, Set<label_t>>& get_back_edges_for_testing(const DirectedGraph& g)
+Map<label_t, Set<label_t>> get_back_edges_for_testing(const DirectedGraph& g)
 {
-    return g.back_edges_;
+    Map<label_t, Set<label_t>> back_edges;
+    for(label_t label = g.first_label_; label < g.end_label(); ++label)
+        if(g.node(label).alive)
+            back_edges[label].insert(g.node(label).predecessors.begin(), g.node(label).predecessors.end());
+    return back_edges;
 }
 
 
-} // namespace lsqecc
\ No newline at end of file
+} // namespace lsqecc
@@ -7,24 +7,24 @@ namespace lsqecc::dag
 
 
 
-DependencyDag<LSInstruction> full_dependency_dag_from_instruction_stream(LSInstructionStream& instruction_stream)
+DependencyDag<LSInstruction> full_dependency_dag_from_instruction_stream(LSInstructionStream& instruction_stream, bool pauli_commutation)
 {
-    DependencyDag<LSInstruction> dag;
+    IncrementalDependencyDagBuilder<LSInstruction> builder{ResourceAccessTrait<LSInstruction>{pauli_commutation}};
     while (instruction_stream.has_next_instruction())
-        dag.push_instruction_based_on_commutation(instruction_stream.get_next_instruction());
+        builder.push_instruction(instruction_stream.get_next_instruction());
 
-    return dag;
+    return builder.release();
 }
 
 
 
 DependencyDag<gates::Gate> full_dependency_dag_from_gate_stream(GateStream& gate_stream)
 {
-    DependencyDag<gates::Gate> dag;
+    IncrementalDependencyDagBuilder<gates::Gate> builder;
     while (gate_stream.has_next_gate())
-        dag.push_instruction_based_on_commutation(gate_stream.get_next_gate());
+        builder.push_instruction(gate_stream.get_next_gate());
 
-    return dag;
+    return builder.release();
 }
 
 } // namespace lsqecc::dag
@@ -177,7 +177,7 @@ tsl::ordered_set<QubitNum> get_operating_qubits(const Gate& gate)
 }
 
 
-CNOTAncillaPlacement ControlledGate::default_ancilla_placement = CNOTAncillaPlacement::USE_DEDICATED_CELL;
+thread_local CNOTAncillaPlacement ControlledGate::default_ancilla_placement = CNOTAncillaPlacement::USE_DEDICATED_CELL;
 
 
 } // namespace lsqecc::gates
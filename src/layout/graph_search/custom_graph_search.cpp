@@ -1,6 +1,9 @@
 #include <lsqecc/layout/graph_search/custom_graph_search.hpp>
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <queue>
 #include <lstk/lstk.hpp>
 
 
@@ -298,6 +301,119 @@ std::optional<RoutingRegion> do_graph_search_route_ancilla(
 }
 
 
+RoutingRegion routing_region_from_path(const std::vector<Cell>& path, Cell source_cell, Cell target_cell)
+{
+    RoutingRegion ret;
+    for (size_t i = 0; i<path.size(); ++i)
+    {
+        const Cell& prec_cell = i==0 ? target_cell : path[i-1];
+        const Cell& next_cell = i==path.size()-1 ? source_cell : path[i+1];
+
+        ret.cells.push_back(SingleCellOccupiedByPatch{
+                {.top=   {BoundaryType::None, false},
+                 .bottom={BoundaryType::None, false},
+                 .left=  {BoundaryType::None, false},
+                 .right= {BoundaryType::None, false}},
+                path[i]
+        });
+
+        for (const Cell& neighbour: {prec_cell, next_cell})
+        {
+            auto boundary = ret.cells.back().get_mut_boundary_with(neighbour);
+            if (boundary) boundary->get() = {.boundary_type=BoundaryType::Connected, .is_active=true};
+        }
+    }
+    return ret;
+}
+
+
+std::vector<RoutingRegion> graph_search_routes_by_parity(
+        const Slice& slice,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        size_t min_route_cells
+)
+{
+    const Cell source_cell = slice.get_cell_by_id(source).value();
+    const Cell target_cell = slice.get_cell_by_id(target).value();
+
+    const SliceSearchAdaptor<false> slice_searcher(slice, source_cell, target_cell, source_op, target_op);
+
+    // A search state is a vertex together with how many route cells were used to get there. Counts are exact below
+    // min_route_cells, above it only their parity is tracked
+    const size_t num_length_classes = min_route_cells + 2;
+    auto length_class = [&](size_t route_cells) {
+        return route_cells < min_route_cells ? route_cells : min_route_cells + route_cells%2;
+    };
+
+    using State = size_t;
+    struct StateData {
+        size_t route_cells;
+        State predecessor;
+    };
+    std::vector<std::optional<StateData>> states(slice_searcher.num_vertices_on_lattice()*num_length_classes);
+
+    auto make_state = [&](Vertex v, size_t route_cells) { return v*num_length_classes + length_class(route_cells); };
+    auto vertex_of = [&](State s) -> Vertex { return s/num_length_classes; };
+
+    auto path_to = [&](State s) {
+        std::vector<Cell> path;
+        while (vertex_of(s) != slice_searcher.source_vertex())
+        {
+            path.push_back(slice_searcher.cell_from_vertex(vertex_of(s)));
+            s = states[s]->predecessor;
+        }
+        return path; // From the last cell of the route back to the first one
+    };
+
+    std::array<std::optional<RoutingRegion>, 2> shortest_by_parity;
+
+    State start = make_state(slice_searcher.source_vertex(), 0);
+    states[start] = StateData{0, start};
+    std::queue<State> frontier;
+    frontier.push(start);
+
+    while (!frontier.empty() && !(shortest_by_parity[0] && shortest_by_parity[1]))
+    {
+        State curr = lstk::queue_pop(frontier);
+        size_t route_cells = states[curr]->route_cells;
+        Cell curr_cell = slice_searcher.cell_from_vertex(vertex_of(curr));
+
+        for (const Cell& neighbour_cell : slice_searcher.get_neighbours(curr_cell))
+        {
+            if (!slice_searcher.have_directed_edge(curr_cell, neighbour_cell))
+                continue;
+
+            if (neighbour_cell == target_cell)
+            {
+                if (route_cells >= min_route_cells && !shortest_by_parity[route_cells%2])
+                    shortest_by_parity[route_cells%2] = routing_region_from_path(path_to(curr), source_cell, target_cell);
+                continue;
+            }
+
+            State next = make_state(slice_searcher.make_vertex(neighbour_cell), route_cells+1);
+            if (states[next])
+                continue;
+
+            // States only track lengths, so make sure the route does not go through the same cell twice
+            std::vector<Cell> path_so_far = path_to(curr);
+            if (std::find(path_so_far.begin(), path_so_far.end(), neighbour_cell) != path_so_far.end())
+                continue;
+
+            states[next] = StateData{route_cells+1, curr};
+            frontier.push(next);
+        }
+    }
+
+    std::vector<RoutingRegion> ret;
+    for (auto& route : shortest_by_parity)
+        if (route) ret.push_back(std::move(*route));
+    return ret;
+}
+
+
 template<Heuristic heuristic>
 std::optional<RoutingRegion> graph_search_route_ancilla_dispatc_heuristic(
         const Slice& slice,
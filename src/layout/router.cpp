@@ -37,6 +37,31 @@ std::optional<RoutingRegion> CachedRouter::find_routing_ancilla(const Slice& sli
 }
 
 
+std::vector<RoutingRegion> CachedRouter::find_routing_ancillas_by_parity(const Slice& slice, PatchId source,
+        PauliOperator source_op, PatchId target, PauliOperator target_op, size_t min_route_cells) const
+{
+    return router_impl_.find_routing_ancillas_by_parity(slice, source, source_op, target, target_op, min_route_cells);
+}
+
+
+std::optional<RoutingRegion> TimedRouter::find_routing_ancilla(const Slice& slice, PatchId source,
+        PauliOperator source_op, PatchId target, PauliOperator target_op) const
+{
+    auto start = std::chrono::steady_clock::now();
+    auto route = router_.find_routing_ancilla(slice, source, source_op, target, target_op);
+    routing_time_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return route;
+}
+
+std::vector<RoutingRegion> TimedRouter::find_routing_ancillas_by_parity(const Slice& slice, PatchId source,
+        PauliOperator source_op, PatchId target, PauliOperator target_op, size_t min_route_cells) const
+{
+    auto start = std::chrono::steady_clock::now();
+    auto routes = router_.find_routing_ancillas_by_parity(slice, source, source_op, target, target_op, min_route_cells);
+    routing_time_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return routes;
+}
+
 
 size_t CachedRouter::PathIdentifier::hash::operator()(
         const CachedRouter::PathIdentifier& x) const
@@ -70,5 +95,13 @@ std::optional<RoutingRegion>CustomDPRouter::find_routing_ancilla(
 }
 
 
+std::vector<RoutingRegion> CustomDPRouter::find_routing_ancillas_by_parity(const Slice& slice, PatchId source,
+        PauliOperator source_op, PatchId target, PauliOperator target_op, size_t min_route_cells) const
+{
+    // All providers agree on shortest paths, so the breadth first search is used regardless of graph_search_provider_
+    return custom_graph_search::graph_search_routes_by_parity(slice, source, source_op, target, target_op, min_route_cells);
+}
+
+
 
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <lsqecc/ls_instructions/ls_instructions.hpp>
 
+#include <algorithm>
+#include <set>
 #include <sstream>
 #include <vector>
 
@@ -64,6 +66,42 @@ std::ostream& operator<<(std::ostream& os, const Move& instruction)
 
     return os;
 }
+
+std::vector<Cell> get_operating_cells(const LocalLSInstruction& instruction)
+{
+    return std::visit(lstk::overloaded{
+        [](const PrepareY& op) -> std::vector<Cell> { return {op.target_cell}; },
+        [](const BellPrepare& op) -> std::vector<Cell> { return {op.cell1, op.cell2}; },
+        [](const BellMeasure& op) -> std::vector<Cell> { return {op.cell1, op.cell2}; },
+        [](const TwoPatchMeasure& op) -> std::vector<Cell> { return {op.cell1, op.cell2}; },
+        [](const ExtendSplit& op) -> std::vector<Cell> { return {op.target_cell, op.extension_cell}; },
+        [](const MergeContract& op) -> std::vector<Cell> { return {op.preserved_cell, op.measured_cell}; },
+        [](const Move& op) -> std::vector<Cell> { return {op.source_cell, op.target_cell}; }
+    }, instruction.operation);
+}
+
+size_t local_instruction_depth(const std::vector<LocalLSInstruction>& instructions)
+{
+    if (instructions.empty())
+        return 0;
+
+    size_t depth = 1;
+    std::set<Cell> used_in_current_slice;
+    for (const auto& instruction : instructions)
+    {
+        auto cells = get_operating_cells(instruction);
+        bool must_wait = std::any_of(cells.begin(), cells.end(),
+                [&](const Cell& cell){ return used_in_current_slice.contains(cell); });
+        if (must_wait)
+        {
+            depth++;
+            used_in_current_slice.clear();
+        }
+        used_in_current_slice.insert(cells.begin(), cells.end());
+    }
+    return depth;
+}
+
 }
 
 
@@ -9,6 +9,29 @@
 namespace lsqecc {
 using namespace std::string_literals;
 
+namespace {
+
+LSInstruction parse_ls_instruction_on_line(std::string_view line, size_t line_number)
+{
+    try {
+        return parse_ls_instruction(line);
+    } catch (const InstructionParseException& e) {
+        throw std::runtime_error{
+                "Encountered parsing exception at line "s+std::to_string(line_number)+":\n"s+e.what()};
+    }
+}
+
+tsl::ordered_set<PatchId> declared_core_qubits(const LSInstruction& first_instruction)
+{
+    if(!std::holds_alternative<DeclareLogicalQubitPatches>(first_instruction.operation))
+        throw std::runtime_error("First instruction must be qubit declaration");
+
+    return std::get<DeclareLogicalQubitPatches>(first_instruction.operation).patch_ids;
+}
+
+}
+
+
 void LSInstructionStreamFromFile::advance_instruction()
 {
     std::string line;
@@ -24,14 +47,7 @@ void LSInstructionStreamFromFile::advance_instruction()
         return;
     }
 
-    next_instruction_ = [&](){
-        try {
-            return parse_ls_instruction(std::string_view{line});
-        } catch (const InstructionParseException& e) {
-            throw std::runtime_error{
-                    "Encountered parsing exception at line "s+std::to_string(line_number_)+":\n"s+e.what()};
-        }
-    }();
+    next_instruction_ = parse_ls_instruction_on_line(line, line_number_);
 }
 
 
@@ -45,10 +61,7 @@ LSInstructionStreamFromFile::LSInstructionStreamFromFile(std::istream& instructi
 
     LSInstruction first_instruction = next_instruction_.value();
     advance_instruction();
-    if(!std::holds_alternative<DeclareLogicalQubitPatches>(first_instruction.operation))
-        throw std::runtime_error("First instruction must be qubit declaration");
-
-    core_qubits_ = std::get<DeclareLogicalQubitPatches>(first_instruction.operation).patch_ids;
+    core_qubits_ = declared_core_qubits(first_instruction);
 }
 
 LSInstruction LSInstructionStreamFromFile::get_next_instruction()
@@ -59,6 +72,46 @@ LSInstruction LSInstructionStreamFromFile::get_next_instruction()
 }
 
 
+void LSInstructionStreamFromMappedFile::advance_instruction()
+{
+    // Same lines as std::getline gives, including an empty one after a trailing newline
+    std::string_view line;
+    while(lines_.has_next() && line.empty())
+    {
+        line = lines_.next();
+        line_number_++;
+    }
+
+    if(line.empty())
+    {
+        next_instruction_ = std::nullopt;
+        return;
+    }
+
+    next_instruction_ = parse_ls_instruction_on_line(line, line_number_);
+}
+
+
+LSInstructionStreamFromMappedFile::LSInstructionStreamFromMappedFile(const std::string& path)
+    : file_(path), lines_(file_.contents(), '\n')
+{
+    advance_instruction();
+    if(!next_instruction_)
+        throw std::runtime_error("No instructions");
+
+    LSInstruction first_instruction = next_instruction_.value();
+    advance_instruction();
+    core_qubits_ = declared_core_qubits(first_instruction);
+}
+
+LSInstruction LSInstructionStreamFromMappedFile::get_next_instruction()
+{
+    LSInstruction instruction = std::move(next_instruction_.value());
+    advance_instruction();
+    return instruction;
+}
+
+
 
 LSInstruction LSInstructionStreamFromGateStream::get_next_instruction()
 {
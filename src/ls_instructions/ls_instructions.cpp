@@ -63,6 +63,38 @@ tsl::ordered_set<PatchId> LSInstruction::get_operating_patches() const
     return ret;
 }
 
+std::optional<PauliOperator> LSInstruction::pauli_basis_on(PatchId patch_id) const
+{
+    if (clients.contains(patch_id))
+        return std::nullopt;
+
+    return std::visit(lstk::overloaded{
+        [&](const MultiPatchMeasurement& op) -> std::optional<PauliOperator> {
+            auto it = op.observable.find(patch_id);
+            if (it == op.observable.end())
+                return std::nullopt;
+            return it->second;
+        },
+        [&](const SingleQubitOp& op) -> std::optional<PauliOperator> {
+            if (op.target != patch_id)
+                return std::nullopt;
+            switch (op.op)
+            {
+                case SingleQubitOp::Operator::X: return PauliOperator::X;
+                case SingleQubitOp::Operator::Y: return PauliOperator::Y;
+                case SingleQubitOp::Operator::Z: return PauliOperator::Z;
+                case SingleQubitOp::Operator::S: return PauliOperator::Z; // Diagonal, so it commutes like Z
+                case SingleQubitOp::Operator::H: return std::nullopt;
+            }
+            LSTK_UNREACHABLE;
+        },
+        [&](const auto&) -> std::optional<PauliOperator> {
+            // Measuring a single patch consumes it, and the others change which patches there are
+            return std::nullopt;
+        }
+    }, operation);
+}
+
 std::ostream& operator<<(std::ostream& os, const LSInstruction& instruction)
 {
     std::visit([&os](auto&& op){ os << op;}, instruction.operation);
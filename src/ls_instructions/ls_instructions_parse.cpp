@@ -6,23 +6,46 @@
 #include <tsl/ordered_set.h>
 
 
+#include <array>
 #include <stdexcept>
+#include <utility>
 
 namespace lsqecc {
 
 
+namespace {
+
+// Splits a "key:value" pair. Empty if it doesn't have exactly two parts
+std::optional<std::pair<std::string_view, std::string_view>> split_key_value(std::string_view pair)
+{
+    lstk::Splitter parts{pair, ':'};
+    if(!parts.has_next())
+        return std::nullopt;
+    std::string_view key = parts.next();
+    if(!parts.has_next())
+        return std::nullopt;
+    std::string_view value = parts.next();
+    if(parts.has_next())
+        return std::nullopt;
+    return std::pair{key, value};
+}
+
+}
+
+
 tsl::ordered_map<PatchId, PauliOperator> parse_multi_body_measurement_dict(std::string_view dict_arg)
 {
-    auto dict_pairs = lstk::split_on(dict_arg, ',');
+    lstk::Splitter dict_pairs{dict_arg, ','};
     tsl::ordered_map<PatchId, PauliOperator> ret;
 
-    for (auto pair: dict_pairs)
+    while (dict_pairs.has_next())
     {
-        auto assoc = lstk::split_on(pair, ':');
-        if (assoc.size()!=2)
+        auto pair = dict_pairs.next();
+        auto assoc = split_key_value(pair);
+        if (!assoc)
             throw InstructionParseException{std::string{"MultiBody dict_pairs not in key pair format:"}+std::string{pair}};
 
-        ret.insert_or_assign(parse_patch_id(assoc[0]), PauliOperator_from_string(assoc[1]));
+        ret.insert_or_assign(parse_patch_id(assoc->first), PauliOperator_from_string(assoc->second));
     }
     return ret;
 }
@@ -30,24 +53,23 @@ tsl::ordered_map<PatchId, PauliOperator> parse_multi_body_measurement_dict(std::
 tsl::ordered_set<PatchId> parse_patch_id_list(std::string_view arg)
 {
     tsl::ordered_set<PatchId> ret;
-    auto entries = lstk::split_on(arg, ',');
-    for(auto e : entries)
+    lstk::Splitter entries{arg, ','};
+    while(entries.has_next())
     {
-        ret.insert(parse_patch_id(e));
+        ret.insert(parse_patch_id(entries.next()));
     }
     return ret;
 }
 
 LSInstruction parse_ls_instruction(std::string_view line)
 {
-    auto args = lstk::split_on(line,' ');
-    auto args_itr = args.begin();
+    lstk::Splitter args{line,' '};
 
-    auto has_next_arg = [&](){return args_itr<args.end();};
+    auto has_next_arg = [&](){return args.has_next();};
     auto get_next_arg = [&](){
         if(!has_next_arg())
             throw InstructionParseException{"Out of arguments"};
-        return *args_itr++;
+        return args.next();
     };
 
     std::string_view instruction = get_next_arg();
@@ -63,8 +85,9 @@ LSInstruction parse_ls_instruction(std::string_view line)
         std::optional<PlaceNexTo> place_next_to;
         if(has_next_arg())
         {
-            auto placement_info = lstk::split_on(get_next_arg(),':');
-            place_next_to = PlaceNexTo{parse_patch_id(placement_info.at(0)),PauliOperator_from_string(placement_info.at(1))}; 
+            lstk::Splitter placement_info{get_next_arg(),':'};
+            auto near_patch = parse_patch_id(placement_info.next());
+            place_next_to = PlaceNexTo{near_patch,PauliOperator_from_string(placement_info.next())};
         }
 
         return {.operation = PatchInit{patch_id, state, place_next_to}, .clients = {patch_id}};
@@ -112,21 +135,24 @@ LSInstruction parse_ls_instruction(std::string_view line)
         auto side1 = parse_patch_id(get_next_arg());
         auto side2 = parse_patch_id(get_next_arg());
         auto patches_dict = get_next_arg();
-        auto dict_pairs = lstk::split_on(patches_dict, ',');
-        std::vector<PlaceNexTo> locs;
+        lstk::Splitter dict_pairs{patches_dict, ','};
+        std::array<PlaceNexTo, 2> locs;
         size_t counter = 0;
-        for (auto pair: dict_pairs) 
+        while (dict_pairs.has_next())
         {
-            auto assoc = lstk::split_on(pair, ':'); 
-            if (assoc.size()!=2)
+            auto pair = dict_pairs.next();
+            auto assoc = split_key_value(pair);
+            if (!assoc)
                 throw InstructionParseException{std::string{"BellPairInit dict_pairs not in key pair format:"}+std::string{pair}};
 
             if (counter > 1) {
                 throw InstructionParseException{std::string{"BellPairInit more than two locations specified."}};
             }
-            locs.push_back(PlaceNexTo{parse_patch_id(assoc[0]), PauliOperator_from_string(assoc[1])});
+            locs[counter] = PlaceNexTo{parse_patch_id(assoc->first), PauliOperator_from_string(assoc->second)};
             counter++;
         }
+        if (counter < 2)
+            throw InstructionParseException{std::string{"BellPairInit fewer than two locations specified."}};
         return {BellPairInit{side1, side2, locs[0], locs[1]}};
     }      
     else if(instruction == "RequestYState" || instruction == "9")
@@ -154,10 +180,11 @@ InMemoryLogicalLatticeComputation parse_ls_instructions(std::string_view source)
 {
     InMemoryLogicalLatticeComputation computation;
 
-    auto view = lstk::split_on(source,'\n');
+    lstk::Splitter lines{source,'\n'};
     bool got_patch_id_list = false;
-    for (auto line : view)
+    while (lines.has_next())
     {
+        auto line = lines.next();
         if(!line.empty())
         {
             auto instruction = parse_ls_instruction(line);
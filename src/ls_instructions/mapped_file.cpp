@@ -0,0 +1,74 @@
+#include <lsqecc/ls_instructions/mapped_file.hpp>
+
+#include <lstk/lstk.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if __has_include(<sys/mman.h>)
+#define LSQECC_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace lsqecc {
+
+
+#ifdef LSQECC_HAS_MMAP
+
+MappedFile::MappedFile(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        throw std::runtime_error{lstk::cat("Could not open file: ", path)};
+
+    struct stat file_stat;
+    if(::fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode))
+    {
+        ::close(fd);
+        throw std::runtime_error{lstk::cat("Can only map regular files: ", path)};
+    }
+
+    // mmap refuses empty files
+    if(file_stat.st_size > 0)
+    {
+        size_t size = static_cast<size_t>(file_stat.st_size);
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error{lstk::cat("Could not map file: ", path)};
+        }
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+        contents_ = std::string_view{static_cast<const char*>(mapping), size};
+    }
+    // The mapping stays valid without the descriptor
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if(!contents_.empty())
+        ::munmap(const_cast<char*>(contents_.data()), contents_.size());
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+{
+    std::ifstream file{path, std::ios::binary};
+    if(!file)
+        throw std::runtime_error{lstk::cat("Could not open file: ", path)};
+    read_contents_.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    contents_ = read_contents_;
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+
+}
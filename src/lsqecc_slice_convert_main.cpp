@@ -0,0 +1,96 @@
+#include <lsqecc/patches/slice_binary.hpp>
+#include <lsqecc/patches/slices_to_json.hpp>
+
+#include <argparse/argparse.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+
+// Turns slices written by lsqecc_slicer --sliceformat binary into the JSON lsqecc_slicer writes by default
+int main(int argc, const char* argv[])
+{
+    using namespace lsqecc;
+
+    argparse::ArgumentParser parser(argv[0], "Convert binary slices to JSON");
+    parser.add_argument()
+            .names({"-i", "--input"})
+            .description("File with binary slices. If not provided will read them from stdin")
+            .required(false);
+    parser.add_argument()
+            .names({"-o", "--output"})
+            .description("File name of output. When not provided outputs to stdout")
+            .required(false);
+    parser.add_argument()
+            .names({"--compactjson"})
+            .description("Write the slices' JSON without indentation")
+            .required(false);
+    parser.enable_help();
+
+    auto err = parser.parse(argc, argv);
+    if (err)
+    {
+        std::cerr << err << std::endl;
+        parser.print_help();
+        return -1;
+    }
+    if (parser.exists("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    std::reference_wrapper<std::istream> in_stream = std::ref(std::cin);
+    std::unique_ptr<std::ifstream> _ifstream_store;
+    if (parser.exists("i"))
+    {
+        _ifstream_store = std::make_unique<std::ifstream>(parser.get<std::string>("i"), std::ios::in | std::ios::binary);
+        if (_ifstream_store->fail())
+        {
+            std::cerr << "Could not open slice file: " << parser.get<std::string>("i") << std::endl;
+            return -1;
+        }
+        in_stream = std::ref(*_ifstream_store);
+    }
+
+    std::reference_wrapper<std::ostream> out_stream = std::ref(std::cout);
+    std::unique_ptr<std::ofstream> _ofstream_store;
+    if (parser.exists("o"))
+    {
+        _ofstream_store = std::make_unique<std::ofstream>(parser.get<std::string>("o"));
+        out_stream = std::ref(*_ofstream_store);
+    }
+
+    try
+    {
+        SliceBinaryHeader header = read_slice_binary_header(in_stream.get());
+        SliceJsonWriter json_writer{header.furthest_cell, header.timer_cells, parser.exists("compactjson")};
+
+        std::vector<std::optional<DensePatch>> cells;
+        std::vector<SurfaceCodeTimestep> timers;
+        uint32_t repeats;
+        std::string buffer;
+        bool is_first_slice = true;
+        while (read_slice_binary(in_stream.get(), header, cells, timers, repeats))
+        {
+            buffer.assign(is_first_slice ? "[\n" : ",\n");
+            json_writer.write(cells, timers, buffer, repeats);
+            out_stream.get().write(buffer.data(), std::streamsize(buffer.size()));
+            is_first_slice = false;
+        }
+        // Byte for byte what the slicer writes, which only opens the array on the first slice
+        out_stream.get() << "]" << std::endl;
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <lsqecc/patches/async_slice_writer.hpp>
+
+#include <stdexcept>
+
+
+namespace lsqecc {
+
+
+AsyncSliceWriter::AsyncSliceWriter(
+        const Layout& layout,
+        size_t capacity,
+        size_t serializer_count,
+        SliceSerializer serializer,
+        SerializedSliceWriter writer)
+    : header_(slice_binary_header(layout)),
+      serializer_(std::move(serializer)),
+      writer_(std::move(writer)),
+      entries_(capacity)
+{
+    if (capacity == 0 || serializer_count == 0)
+        throw std::invalid_argument{"AsyncSliceWriter needs room for a slice and a serializer at least"};
+    for (size_t i = 0; i < serializer_count; i++)
+        unpacked_slices_.emplace_back(layout);
+    for (size_t i = 0; i < serializer_count; i++)
+        serializer_threads_.emplace_back([this, i](){ serialize(i); });
+    sequencer_thread_ = std::thread{[this](){ sequence(); }};
+}
+
+
+AsyncSliceWriter::~AsyncSliceWriter()
+{
+    stop();
+}
+
+
+void AsyncSliceWriter::push(const DenseSlice& slice, size_t repeats)
+{
+    size_t entry;
+    {
+        std::unique_lock lock{mutex_};
+        slice_written_.wait(lock, [this](){ return pushed_ - written_ < entries_.size() || error_; });
+        rethrow_error();
+        entry = pushed_ % entries_.size();
+    }
+
+    // The other threads only touch entries of slices pushed and not yet written, so this one can be filled in without
+    // the lock
+    pack_slice(header_, slice, entries_[entry].slice);
+    entries_[entry].repeats = repeats;
+
+    {
+        std::lock_guard lock{mutex_};
+        pushed_++;
+    }
+    slice_pushed_.notify_all();
+}
+
+
+void AsyncSliceWriter::finish()
+{
+    {
+        std::unique_lock lock{mutex_};
+        slice_written_.wait(lock, [this](){ return written_ == pushed_ || error_; });
+    }
+    stop();
+    rethrow_error();
+}
+
+
+void AsyncSliceWriter::stop()
+{
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    slice_pushed_.notify_all();
+    slice_serialized_.notify_all();
+    for (auto& thread : serializer_threads_)
+        if (thread.joinable())
+            thread.join();
+    if (sequencer_thread_.joinable())
+        sequencer_thread_.join();
+}
+
+
+void AsyncSliceWriter::rethrow_error()
+{
+    if (error_)
+        std::rethrow_exception(error_);
+}
+
+
+void AsyncSliceWriter::serialize(size_t serializer_index)
+{
+    // Serializers take slices in turns
+    for (size_t slice_number = serializer_index; ; slice_number += serializer_threads_.size())
+    {
+        {
+            std::unique_lock lock{mutex_};
+            slice_pushed_.wait(lock, [&](){ return pushed_ > slice_number || stopping_ || error_; });
+            if (stopping_ || error_)
+                return;
+        }
+
+        Entry& entry = entries_[slice_number % entries_.size()];
+        try
+        {
+            unpack_slice(entry.slice, unpacked_slices_[serializer_index]);
+            entry.serialized.clear();
+            serializer_(unpacked_slices_[serializer_index], entry.repeats, entry.serialized);
+        }
+        catch (...)
+        {
+            std::lock_guard lock{mutex_};
+            error_ = std::current_exception();
+            slice_written_.notify_all();
+            slice_serialized_.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard lock{mutex_};
+            entry.is_serialized = true;
+        }
+        slice_serialized_.notify_one();
+    }
+}
+
+
+void AsyncSliceWriter::sequence()
+{
+    while (true)
+    {
+        Entry* entry;
+        {
+            std::unique_lock lock{mutex_};
+            slice_serialized_.wait(lock, [&](){
+                return (written_ < pushed_ && entries_[written_ % entries_.size()].is_serialized) || stopping_ || error_;
+            });
+            // finish only stops the threads once all slices are written
+            if (stopping_ || error_)
+                return;
+            entry = &entries_[written_ % entries_.size()];
+        }
+
+        try
+        {
+            writer_(entry->serialized);
+        }
+        catch (...)
+        {
+            std::lock_guard lock{mutex_};
+            error_ = std::current_exception();
+            slice_written_.notify_all();
+            slice_pushed_.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard lock{mutex_};
+            entry->is_serialized = false;
+            written_++;
+        }
+        slice_written_.notify_all();
+    }
+}
+
+}
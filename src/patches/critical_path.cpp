@@ -0,0 +1,52 @@
+#include <lsqecc/patches/critical_path.hpp>
+
+#include <cstdlib>
+#include <limits>
+
+namespace lsqecc {
+
+
+size_t estimated_instruction_duration(const LSInstruction& instruction)
+{
+    if (std::get_if<DeclareLogicalQubitPatches>(&instruction.operation))
+        return 0;
+    else if (std::get_if<RotateSingleCellPatch>(&instruction.operation))
+        return ROTATION_STEPS_TO_CLEAR;
+    else if (const auto* busy_region = std::get_if<BusyRegion>(&instruction.operation))
+        return busy_region->steps_to_clear + 1;
+    else if (const auto* op = std::get_if<SingleQubitOp>(&instruction.operation))
+        // S gates are a merge followed by a Z correction
+        return op->op == SingleQubitOp::Operator::S ? 2 : 1;
+    else
+        return 1;
+}
+
+size_t critical_path_weight(const LSInstruction& instruction)
+{
+    size_t weight = estimated_instruction_duration(instruction);
+    if (std::get_if<MagicStateRequest>(&instruction.operation))
+        weight += CRITICAL_PATH_T_WEIGHT;
+    return weight;
+}
+
+std::optional<size_t> magic_state_distance(const DenseSlice& slice, const MagicStateArrival& next_arrival, const LSInstruction& instruction)
+{
+    const auto* request = std::get_if<MagicStateRequest>(&instruction.operation);
+    if (!request) return std::nullopt;
+    auto near_cell = slice.get_cell_by_id(request->near_patch);
+    if (!near_cell) return std::nullopt;
+
+    auto distance_to = [&](const Cell& cell) -> size_t
+    {
+        return std::abs(cell.row - near_cell->row) + std::abs(cell.col - near_cell->col);
+    };
+    if (next_arrival.steps > 0)
+        return distance_to(next_arrival.cell);
+
+    size_t min_distance = std::numeric_limits<size_t>::max();
+    for (const Cell& cell : slice.magic_states)
+        min_distance = std::min(min_distance, distance_to(cell));
+    return min_distance;
+}
+
+}
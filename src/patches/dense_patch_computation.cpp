@@ -1,5 +1,6 @@
 #include <lsqecc/patches/dense_patch_computation.hpp>
 #include <lsqecc/dag/domain_dags.hpp>
+#include <lsqecc/scheduler/scheduler_policy.hpp>
 #include <lsqecc/scheduler/wave_scheduler.hpp>
 
 #include <algorithm>
@@ -40,7 +41,7 @@ BusyRegion single_patch_rotation_a_la_litinski(
    SparsePatch new_patch{target_patch};
    std::get<SingleCellOccupiedByPatch>(new_patch.cells).instant_rotate();
 
-   return {.region = occupied_space, .steps_to_clear=3, .state_after_clearing = {new_patch}};
+   return {.region = occupied_space, .steps_to_clear=ROTATION_STEPS_TO_CLEAR, .state_after_clearing = {new_patch}};
 }
 
 
@@ -155,6 +156,78 @@ void advance_slice(DenseSlice& slice, const Layout& layout)
     }
 }
 
+/**
+ * Slices until the next magic state is distilled, if advancing the slice until then would only count down distillation
+ * timers: no patch is left to deactivate or clear, and no reserved tile to restart distillation on
+ */
+std::optional<SurfaceCodeTimestep> slices_until_magic_state(const DenseSlice& slice, const Layout& layout)
+{
+    if (!slice.magic_states.empty())
+        return std::nullopt;
+
+    bool settled = true;
+    slice.traverse_cells([&](const Cell& c, const std::optional<DensePatch>& p) {
+        LSTK_UNUSED(c);
+        if (p && (p->activity == PatchActivity::Unitary
+                  || p->activity == PatchActivity::Measurement
+                  || p->activity == PatchActivity::MultiPatchMeasurement
+                  || p->boundaries.top.is_active || p->boundaries.bottom.is_active
+                  || p->boundaries.left.is_active || p->boundaries.right.is_active))
+            settled = false;
+    });
+    if (!settled)
+        return std::nullopt;
+
+    std::optional<SurfaceCodeTimestep> slices;
+    if (layout.magic_states_reserved())
+    {
+        size_t reserved_cell_index = 0;
+        for (const Cell& cell: layout.reserved_for_magic_states())
+        {
+            if (slice.is_cell_free(cell))
+                return std::nullopt;
+            // Timers of tiles holding a bound state are paused
+            if (slice.patch_at(cell)->type == PatchType::Distillation)
+            {
+                auto time_to_magic_state_here = slice.time_to_next_magic_state_by_distillation_region[reserved_cell_index];
+                slices = std::min(slices.value_or(time_to_magic_state_here), time_to_magic_state_here);
+            }
+            reserved_cell_index++;
+        }
+    }
+    else
+    {
+        for (auto time_to_magic_state_here: slice.time_to_next_magic_state_by_distillation_region)
+            slices = std::min(slices.value_or(time_to_magic_state_here), time_to_magic_state_here);
+    }
+
+    if (!slices || *slices == 0)
+        return std::nullopt;
+    return slices;
+}
+
+// Same as advancing an idle slice `slices` times, for as many as slices_until_magic_state allows
+void fast_forward_slice(DenseSlice& slice, const Layout& layout, SurfaceCodeTimestep slices)
+{
+    // No timer runs out before the last advance, which is left to advance_slice to distill the state
+    if (layout.magic_states_reserved())
+    {
+        size_t reserved_cell_index = 0;
+        for (const Cell& cell: layout.reserved_for_magic_states())
+        {
+            if (slice.patch_at(cell)->type == PatchType::Distillation)
+                slice.time_to_next_magic_state_by_distillation_region[reserved_cell_index] -= slices-1;
+            reserved_cell_index++;
+        }
+    }
+    else
+    {
+        for (auto& time_to_magic_state_here: slice.time_to_next_magic_state_by_distillation_region)
+            time_to_magic_state_here -= slices-1;
+    }
+    advance_slice(slice, layout);
+}
+
 
 void stitch_boundaries(
         DenseSlice& slice,
@@ -225,6 +298,162 @@ bool merge_patches(
 }
 
 
+static constexpr size_t MIN_BELL_PAIR_ROUTE_CELLS = 2;
+
+
+std::vector<LocalInstruction::LocalLSInstruction> bell_pair_init_local_instructions(
+        const BellPairInit& bell_init,
+        const RoutingRegion& routing_region)
+{
+    std::vector<LocalInstruction::LocalLSInstruction> local_instructions;
+    local_instructions.reserve(routing_region.cells.size());
+    std::optional<PatchId> id1; std::optional<PatchId> id2;
+    for (size_t i=0; i<routing_region.cells.size()-1; i=i+2)
+    {
+        // Push a BellPrepare instruction with PatchID's depending on the case
+        id1 = std::nullopt; id2 = std::nullopt;
+        if (i==0) 
+            id1 = bell_init.side2;
+        if (i==routing_region.cells.size()-2)
+            id2 = bell_init.side1;
+
+        local_instructions.push_back({LocalInstruction::BellPrepare{id1, id2, routing_region.cells[i].cell, routing_region.cells[i+1].cell}});
+    }
+    for (size_t i=2; i<routing_region.cells.size()-1; i=i+2)
+    {
+        // Push a complementary layer of BellMeasure instructions
+        local_instructions.push_back({LocalInstruction::BellMeasure{routing_region.cells[i-1].cell, routing_region.cells[i].cell}});
+    }
+    // Take care of the case of an odd route
+    if ((routing_region.cells.size()%2 == 1))
+    {
+        local_instructions.push_back({LocalInstruction::Move{
+            routing_region.cells[routing_region.cells.size()-2].cell, 
+            routing_region.cells[routing_region.cells.size()-1].cell,
+            bell_init.side1
+        }});
+    }
+    return local_instructions;
+}
+
+
+std::vector<LocalInstruction::LocalLSInstruction> bell_based_cnot_local_instructions(
+        const BellBasedCNOT& bell_cnot,
+        const Cell& control_cell,
+        const Cell& target_cell,
+        const RoutingRegion& routing_region)
+{
+    std::vector<LocalInstruction::LocalLSInstruction> local_instructions;
+    local_instructions.reserve(2*routing_region.cells.size());
+
+    // Offset boolean for even vs. odd routes
+    bool even_route = (routing_region.cells.size()%2 == 0);
+
+    // See PRX Quantum 3, 020342 (2022) Fig. 19a and c for even vs. odd route compilation
+    if (!even_route)
+    {
+        local_instructions.push_back({LocalInstruction::ExtendSplit{
+            std::nullopt,
+            control_cell, 
+            routing_region.cells[routing_region.cells.size()-1].cell
+        }});
+    }
+    std::optional<PatchId> id1; std::optional<PatchId> id2;
+    for (size_t i=0; i<routing_region.cells.size()-1; i=i+2)
+    {
+        // Push a BellPrepare instruction with PatchID's depending on the case
+        id1 = std::nullopt; id2 = std::nullopt;
+        if (i==0)
+            id1 = bell_cnot.side2;
+        if (i==routing_region.cells.size()-2-!even_route)
+            id2 = bell_cnot.side1;
+
+        local_instructions.push_back({LocalInstruction::BellPrepare{id1, id2, routing_region.cells[i].cell, routing_region.cells[i+1].cell}});
+    }
+    for (size_t i=2; i<routing_region.cells.size()-even_route; i=i+2)
+    {
+        // Push a complementary layer of BellMeasure instructions
+        local_instructions.push_back({LocalInstruction::BellMeasure{routing_region.cells[i-1].cell, routing_region.cells[i].cell}});
+    }
+    // Add final measurements
+    local_instructions.push_back({LocalInstruction::MergeContract{target_cell, routing_region.cells[0].cell}});
+    if (even_route)
+    {
+        local_instructions.push_back({LocalInstruction::MergeContract{control_cell, routing_region.cells[routing_region.cells.size()-1].cell}});                    
+    }
+    return local_instructions;
+}
+
+
+/*
+ * With LocalRoutingMode::ParityAware, picks the route that compiles to the fewest slices of local instructions among
+ * the shortest routes of each parity that are long enough to hold a Bell pair, breaking ties by length. This way a
+ * detour is taken when the shortest route is too short or its parity costs an extra step.
+ */
+template<class CompileToLocalInstructions>
+std::optional<RoutingRegion> find_local_instruction_route(
+        const DenseSlice& slice,
+        Router& router,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        CompileToLocalInstructions compile_to_local_instructions)
+{
+    if (router.local_routing_mode() == LocalRoutingMode::ShortestPath)
+        return router.find_routing_ancilla(slice, source, source_op, target, target_op);
+
+    std::optional<RoutingRegion> cheapest_route;
+    size_t cheapest_depth = 0;
+    for (auto& route : router.find_routing_ancillas_by_parity(slice, source, source_op, target, target_op, MIN_BELL_PAIR_ROUTE_CELLS))
+    {
+        size_t depth = LocalInstruction::local_instruction_depth(compile_to_local_instructions(route));
+        if (!cheapest_route || depth < cheapest_depth
+            || (depth == cheapest_depth && route.cells.size() < cheapest_route->cells.size()))
+        {
+            cheapest_depth = depth;
+            cheapest_route = std::move(route);
+        }
+    }
+    return cheapest_route;
+}
+
+
+WaitCondition patch_active_at(const DenseSlice& slice, const Cell& cell)
+{
+    return {.reason=WaitCondition::Reason::PatchActive, .cell=cell, .patch_id=slice.patch_at(cell)->id};
+}
+
+bool WaitCondition::may_proceed(const DenseSlice& slice) const
+{
+    switch (reason)
+    {
+        case Reason::MagicStateUnavailable:
+            return !slice.magic_states.empty();
+        case Reason::PatchActive:
+        {
+            const auto& patch = slice.patch_at(*cell);
+            return !patch || !patch->is_active() || patch->id != patch_id;
+        }
+        case Reason::CellOccupied:
+        {
+            if (cell)
+            {
+                const auto& patch = slice.patch_at(*cell);
+                if (!patch || patch->id != patch_id)
+                    return true;
+            }
+            return cells_to_clear.empty() || std::any_of(cells_to_clear.begin(), cells_to_clear.end(),
+                    [&](const Cell& c){ return slice.is_cell_free(c); });
+        }
+        case Reason::Unknown:
+        case Reason::RouteBlocked:
+            return true;
+    }
+    LSTK_UNREACHABLE;
+}
+
+
 InstructionApplicationResult try_apply_local_instruction(
         DenseSlice& slice,
         LocalInstruction::LocalLSInstruction instruction)
@@ -271,9 +500,11 @@ InstructionApplicationResult try_apply_local_instruction(
         else if (!slice.patch_at(bellmeas->cell2).has_value())
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; No Patch at ", bellmeas->cell2, ", cannot measure")), {}};
         else if (slice.patch_at(bellmeas->cell1)->is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", bellmeas->cell1, " is active, cannot measure")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", bellmeas->cell1, " is active, cannot measure")), {},
+                    patch_active_at(slice, bellmeas->cell1)};
         else if (slice.patch_at(bellmeas->cell2)->is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", bellmeas->cell2, " is active, cannot measure")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", bellmeas->cell2, " is active, cannot measure")), {},
+                    patch_active_at(slice, bellmeas->cell2)};
 
         slice.get_boundary_between_or_fail(bellmeas->cell1,bellmeas->cell2).get().is_active=true;
         slice.get_boundary_between_or_fail(bellmeas->cell2,bellmeas->cell1).get().is_active=true;
@@ -288,9 +519,11 @@ InstructionApplicationResult try_apply_local_instruction(
         if (!slice.patch_at(move->source_cell).has_value())
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; No Patch at ", move->source_cell, ", cannot move")), {}};
         else if (slice.patch_at(move->source_cell)->is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", move->source_cell, " is active, cannot move")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", move->source_cell, " is active, cannot move")), {},
+                    patch_active_at(slice, move->source_cell)};
         else if (!slice.is_cell_free(move->target_cell))
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Cell ", move->target_cell, " is not free, cannot move")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Cell ", move->target_cell, " is not free, cannot move")), {},
+                    {.reason=WaitCondition::Reason::CellOccupied, .cells_to_clear={move->target_cell}}};
         
         SparsePatch new_patch = LayoutHelpers::basic_square_patch(move->target_cell, std::nullopt, "Move");
         new_patch.id = move->new_id_for_target ? move->new_id_for_target : slice.patch_at(move->source_cell)->id;
@@ -309,9 +542,11 @@ InstructionApplicationResult try_apply_local_instruction(
         else if (!slice.patch_at(localmeas->cell2).has_value())
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; No Patch at ", localmeas->cell2, ", cannot measure")), {}};
         else if (slice.patch_at(localmeas->cell1)->is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", localmeas->cell1, " is active, cannot measure")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", localmeas->cell1, " is active, cannot measure")), {},
+                    patch_active_at(slice, localmeas->cell1)};
         else if (slice.patch_at(localmeas->cell2)->is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", localmeas->cell2, " is active, cannot measure")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", localmeas->cell2, " is active, cannot measure")), {},
+                    patch_active_at(slice, localmeas->cell2)};
 
         slice.get_boundary_between_or_fail(localmeas->cell1,localmeas->cell2).get().is_active=true;
         slice.get_boundary_between_or_fail(localmeas->cell2,localmeas->cell1).get().is_active=true;
@@ -341,9 +576,11 @@ InstructionApplicationResult try_apply_local_instruction(
         else if (!slice.patch_at(mergecont->measured_cell).has_value())
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; No Patch at ", mergecont->measured_cell, ", cannot merge")), {}};
         else if (slice.patch_at(mergecont->preserved_cell)->is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", mergecont->preserved_cell, " is active, cannot merge")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", mergecont->preserved_cell, " is active, cannot merge")), {},
+                    patch_active_at(slice, mergecont->preserved_cell)};
         else if (slice.patch_at(mergecont->measured_cell)->is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", mergecont->measured_cell, " is active, cannot merge")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", mergecont->measured_cell, " is active, cannot merge")), {},
+                    patch_active_at(slice, mergecont->measured_cell)};
 
         slice.get_boundary_between_or_fail(mergecont->preserved_cell,mergecont->measured_cell).get().is_active=true;
         slice.get_boundary_between_or_fail(mergecont->measured_cell,mergecont->preserved_cell).get().is_active=true;
@@ -384,14 +621,15 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         {
             if (!merge_patches(slice, router, p->target, PauliOperator::X, p->target, PauliOperator::Z))
                 return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Could not do S gate routing on ", p->target)),
-                        {}};
+                        {}, {.reason=WaitCondition::Reason::RouteBlocked}};
             LSInstruction corrective_term{SingleQubitOp{p->target, SingleQubitOp::Operator::Z}};
             return {nullptr, {corrective_term}};
         }
         else
         {
             if (target_patch.is_active())
-                return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", p->target, " is active")), {}};
+                return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", p->target, " is active")), {},
+                        patch_active_at(slice, slice.get_cell_by_id(p->target).value())};
             
             if (p->op == SingleQubitOp::Operator::H)
             {
@@ -420,7 +658,8 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         if (!local_instructions) 
         {
             if (!merge_patches(slice, router, source_id, source_op, target_id, target_op))
-                return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Couldn't find room to route")), {}};
+                return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Couldn't find room to route")), {},
+                        {.reason=WaitCondition::Reason::RouteBlocked}};
             
             return {nullptr, {}};
         }
@@ -447,7 +686,7 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
             m->local_instruction = std::move(local_instruction);
             InstructionApplicationResult r = try_apply_local_instruction(slice, local_instruction);
             if (r.maybe_error && r.followup_instructions.empty())
-                return InstructionApplicationResult{std::move(r.maybe_error), {}};
+                return InstructionApplicationResult{std::move(r.maybe_error), {}, std::move(r.wait_condition)};
             if (!r.followup_instructions.empty())
                 return InstructionApplicationResult{std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Followup local instructions not implemented")), {}};
             return {nullptr, {}};
@@ -485,46 +724,21 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         {
             if (!bell_init->counter.has_value())
             {
-                auto routing_region = router.find_routing_ancilla(slice, bell_init->loc1.target, bell_init->loc1.op, bell_init->loc2.target, bell_init->loc2.op);
+                auto routing_region = find_local_instruction_route(
+                        slice, router, bell_init->loc1.target, bell_init->loc1.op, bell_init->loc2.target, bell_init->loc2.op,
+                        [&](const RoutingRegion& route){ return bell_pair_init_local_instructions(*bell_init, route); });
                 if(!routing_region)
                 {
-                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; No valid route found for Bell pair creation")), {}};
-                }
-                else if (routing_region->cells.size() < 2) 
-                {
-                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Shortest route cannot be used for Bell pair creation")), {}};
-                }
-
-                std::vector<LocalInstruction::LocalLSInstruction> local_instructions;
-                local_instructions.reserve(routing_region->cells.size());
-                std::optional<PatchId> id1; std::optional<PatchId> id2;
-                for (size_t i=0; i<routing_region->cells.size()-1; i=i+2)
-                {
-                    // Push a BellPrepare instruction with PatchID's depending on the case
-                    id1 = std::nullopt; id2 = std::nullopt;
-                    if (i==0) 
-                        id1 = bell_init->side2;
-                    if (i==routing_region->cells.size()-2)
-                        id2 = bell_init->side1;
-
-                    local_instructions.push_back({LocalInstruction::BellPrepare{id1, id2, routing_region->cells[i].cell, routing_region->cells[i+1].cell}});
+                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; No valid route found for Bell pair creation")), {},
+                            {.reason=WaitCondition::Reason::RouteBlocked}};
                 }
-                for (size_t i=2; i<routing_region->cells.size()-1; i=i+2)
+                else if (routing_region->cells.size() < MIN_BELL_PAIR_ROUTE_CELLS) 
                 {
-                    // Push a complementary layer of BellMeasure instructions
-                    local_instructions.push_back({LocalInstruction::BellMeasure{routing_region->cells[i-1].cell, routing_region->cells[i].cell}});
-                }
-                // Take care of the case of an odd route
-                if ((routing_region->cells.size()%2 == 1))
-                {
-                    local_instructions.push_back({LocalInstruction::Move{
-                        routing_region->cells[routing_region->cells.size()-2].cell, 
-                        routing_region->cells[routing_region->cells.size()-1].cell,
-                        bell_init->side1
-                    }});
+                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Shortest route cannot be used for Bell pair creation")), {},
+                            {.reason=WaitCondition::Reason::RouteBlocked}};
                 }
 
-                bell_init->local_instructions = std::move(local_instructions);
+                bell_init->local_instructions = bell_pair_init_local_instructions(*bell_init, *routing_region);
                 bell_init->counter = std::pair<unsigned int, unsigned int>(0, 0);
             }
 
@@ -553,9 +767,11 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         auto target_patch = slice.get_patch_by_id(bell_cnot->target);
         
         if (control_patch.value().get().is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", bell_cnot->control, " is active")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", bell_cnot->control, " is active")), {},
+                    patch_active_at(slice, slice.get_cell_by_id(bell_cnot->control).value())};
         if (target_patch.value().get().is_active())
-            return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", bell_cnot->target, " is active")), {}};
+            return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", bell_cnot->target, " is active")), {},
+                    patch_active_at(slice, slice.get_cell_by_id(bell_cnot->target).value())};
         
         if (!local_instructions)
         {
@@ -565,55 +781,23 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         {
             if (!bell_cnot->counter.has_value())
             {
-                auto routing_region = router.find_routing_ancilla(slice, bell_cnot->control, PauliOperator::Z, bell_cnot->target, PauliOperator::X);
+                const Cell control_cell = slice.get_cell_by_id(bell_cnot->control).value();
+                const Cell target_cell = slice.get_cell_by_id(bell_cnot->target).value();
+                auto routing_region = find_local_instruction_route(
+                        slice, router, bell_cnot->control, PauliOperator::Z, bell_cnot->target, PauliOperator::X,
+                        [&](const RoutingRegion& route){ return bell_based_cnot_local_instructions(*bell_cnot, control_cell, target_cell, route); });
                 if(!routing_region) 
                 {
-                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; No valid route found for Bell pair creation")), {}};
+                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; No valid route found for Bell pair creation")), {},
+                            {.reason=WaitCondition::Reason::RouteBlocked}};
                 }
-                else if (routing_region->cells.size() < 2) 
+                else if (routing_region->cells.size() < MIN_BELL_PAIR_ROUTE_CELLS) 
                 {
-                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Shortest route cannot be used for Bell pair creation")), {}};
+                    return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Shortest route cannot be used for Bell pair creation")), {},
+                            {.reason=WaitCondition::Reason::RouteBlocked}};
                 }
 
-                std::vector<LocalInstruction::LocalLSInstruction> local_instructions;
-                local_instructions.reserve(2*routing_region->cells.size());
-
-                // Offset boolean for even vs. odd routes
-                bool even_route = (routing_region->cells.size()%2 == 0);
-
-                // See PRX Quantum 3, 020342 (2022) Fig. 19a and c for even vs. odd route compilation
-                if (!even_route)
-                {
-                    local_instructions.push_back({LocalInstruction::ExtendSplit{
-                        std::nullopt,
-                        slice.get_cell_by_id(bell_cnot->control).value(), 
-                        routing_region->cells[routing_region->cells.size()-1].cell
-                    }});
-                }
-                std::optional<PatchId> id1; std::optional<PatchId> id2;
-                for (size_t i=0; i<routing_region->cells.size()-1; i=i+2)
-                {
-                    // Push a BellPrepare instruction with PatchID's depending on the case
-                    id1 = std::nullopt; id2 = std::nullopt;
-                    if (i==0)
-                        id1 = bell_cnot->side2;
-                    if (i==routing_region->cells.size()-2-!even_route)
-                        id2 = bell_cnot->side1;
-
-                    local_instructions.push_back({LocalInstruction::BellPrepare{id1, id2, routing_region->cells[i].cell, routing_region->cells[i+1].cell}});
-                }
-                for (size_t i=2; i<routing_region->cells.size()-even_route; i=i+2)
-                {
-                    // Push a complementary layer of BellMeasure instructions
-                    local_instructions.push_back({LocalInstruction::BellMeasure{routing_region->cells[i-1].cell, routing_region->cells[i].cell}});
-                }
-                // Add final measurements
-                local_instructions.push_back({LocalInstruction::MergeContract{slice.get_cell_by_id(bell_cnot->target).value(), routing_region->cells[0].cell}});
-                if (even_route)
-                {
-                    local_instructions.push_back({LocalInstruction::MergeContract{slice.get_cell_by_id(bell_cnot->control).value(), routing_region->cells[routing_region->cells.size()-1].cell}});                    
-                }
-                bell_cnot->local_instructions = std::move(local_instructions);
+                bell_cnot->local_instructions = bell_based_cnot_local_instructions(*bell_cnot, control_cell, target_cell, *routing_region);
                 bell_cnot->counter = std::pair<unsigned int, unsigned int>(0, 0);
             }
             bell_cnot->counter->first = bell_cnot->counter->second;
@@ -638,14 +822,16 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         const Cell target_cell = *slice.get_cell_by_id(rotation->target);
 
         std::optional<Cell> free_neighbour;
-
-        for (auto neighbour_cell: slice.get_neigbours_within_slice(target_cell))
+        const auto neighbour_cells = slice.get_neigbours_within_slice(target_cell);
+        for (auto neighbour_cell: neighbour_cells)
             if (slice.is_cell_free(neighbour_cell))
                 free_neighbour = neighbour_cell;
 
         if (!free_neighbour)
             return {std::make_unique<std::runtime_error>(lstk::cat(
-                    instruction,"; Cannot rotate patch ", rotation->target, ": has no free neighbour")), {}};
+                    instruction,"; Cannot rotate patch ", rotation->target, ": has no free neighbour")), {},
+                    {.reason=WaitCondition::Reason::CellOccupied, .cell=target_cell, .patch_id=rotation->target,
+                     .cells_to_clear=neighbour_cells}};
 
         if (slice.patch_at(target_cell)->activity == PatchActivity::Unitary)
         {
@@ -691,7 +877,8 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         else 
         {
             return {std::make_unique<std::runtime_error>(
-                    lstk::cat(instruction,";Could not get magic state")), {}};           
+                    lstk::cat(instruction,";Could not get magic state")), {},
+                    {.reason=WaitCondition::Reason::MagicStateUnavailable}};           
         }
     }
     else if (auto* yr = std::get_if<YStateRequest>(&instruction.operation))
@@ -825,174 +1012,198 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
     LSTK_UNREACHABLE;
 }
 
-void run_through_dense_slices_streamed(
-        LSInstructionStream&& instruction_stream,
-        bool local_instructions,
-        bool allow_twists,
-        const Layout& layout,
-        Router& router,
-        std::optional<std::chrono::seconds> timeout,
-        DenseSliceVisitor slice_visitor,
-        LSInstructionVisitor instruction_visitor,
-        bool graceful,
-        DensePatchComputationResult& res)
+bool ParkedInstructions::CellWaiter::released(const std::optional<DensePatch>& patch) const
+{
+    if (!patch)
+        return true;
+    if (until_free)
+        return false;
+    return patch->id != patch_id || (reason == WaitCondition::Reason::PatchActive && !patch->is_active());
+}
+
+void ParkedInstructions::index(size_t key, ParkedInstruction& parked_instruction)
 {
-    DenseSlice slice{layout, instruction_stream.core_qubits()};
-    std::deque<LSInstruction> future_instructions;
+    parked_instruction.parking = parkings_++;
+    parked_instruction.woken = false;
 
-    while (instruction_stream.has_next_instruction() || !future_instructions.empty())
+    const WaitCondition& wait_condition = parked_instruction.wait_condition;
+    if (wait_condition.reason == WaitCondition::Reason::MagicStateUnavailable)
     {
-        LSInstruction instruction = [&]()
-        {
-            if (!future_instructions.empty())
-                return lstk::deque_pop(future_instructions);
-            res.ls_instructions_count_++;
-            return instruction_stream.get_next_instruction();
-        }();
+        magic_state_waiters_.emplace_back(key, parked_instruction.parking);
+        return;
+    }
+    if (wait_condition.cell)
+        cell_waiters_[*wait_condition.cell].push_back(
+                {key, parked_instruction.parking, wait_condition.reason, wait_condition.patch_id, false});
+    for (const Cell& cell: wait_condition.cells_to_clear)
+        cell_waiters_[cell].push_back({key, parked_instruction.parking, wait_condition.reason, std::nullopt, true});
+}
 
-        auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions, allow_twists, layout, router);
-        if (!application_result.maybe_error)
-            instruction_visitor(instruction);
+void ParkedInstructions::wake(const DenseSlice& slice)
+{
+    slice_changed_ = false;
 
-        if (!application_result.followup_instructions.empty())
-        {
-            slice_visitor(slice);
-            advance_slice(slice, layout);
-            res.slice_count_++;
+    // Left over entries of instructions that were tried or parked again since are dropped on the way
+    auto wake_waiter = [this](size_t key, size_t parking)
+    {
+        auto it = parked_.find(key);
+        if (it != parked_.end() && it->second.parking == parking)
+            it->second.woken = true;
+    };
 
-            for (auto&& i: application_result.followup_instructions)
-                future_instructions.push_back(i);
-        }
-        else if (application_result.maybe_error)
+    if (!slice.magic_states.empty())
+    {
+        for (const auto& [key, parking]: magic_state_waiters_)
+            wake_waiter(key, parking);
+        magic_state_waiters_.clear();
+    }
+
+    for (auto it = cell_waiters_.begin(); it != cell_waiters_.end();)
+    {
+        const auto& patch = slice.patch_at(it->first);
+        auto& waiters = it->second;
+        waiters.erase(std::remove_if(waiters.begin(), waiters.end(), [&](const CellWaiter& waiter)
         {
-            slice_visitor(slice);
-            if (instruction.wait_at_most_for == 0)
-                throw std::runtime_error{application_result.maybe_error->what()};
-            instruction.wait_at_most_for--;
-            future_instructions.push_front(instruction);
-            advance_slice(slice, layout);
-        }
+            if (!waiter.released(patch))
+                return false;
+            wake_waiter(waiter.key, waiter.parking);
+            return true;
+        }), waiters.end());
+        it = waiters.empty() ? cell_waiters_.erase(it) : std::next(it);
     }
-    slice_visitor(slice);
 }
 
+bool ParkedInstructions::may_proceed(const ParkedInstruction& parked_instruction, const DenseSlice& slice) const
+{
+    // Since the last wake, magic states can only have been used up, while cells may also have been released
+    if (!slice_changed_
+        || (!parked_instruction.woken && parked_instruction.wait_condition.reason == WaitCondition::Reason::MagicStateUnavailable))
+        return parked_instruction.woken;
+    return parked_instruction.wait_condition.may_proceed(slice);
+}
 
-void run_through_dense_slices_dag(
-        dag::DependencyDag<LSInstruction>&& dag,
-        const tsl::ordered_set<PatchId>& core_qubits,
+bool ParkedInstructions::waiting(size_t key, const DenseSlice& slice) const
+{
+    auto it = parked_.find(key);
+    return it != parked_.end() && !may_proceed(it->second, slice);
+}
+
+bool ParkedInstructions::waiting_on_magic_state(size_t key, const DenseSlice& slice) const
+{
+    // Asked between slices, so this does not rely on wake
+    auto it = parked_.find(key);
+    return it != parked_.end() && it->second.wait_condition.reason == WaitCondition::Reason::MagicStateUnavailable
+        && !it->second.wait_condition.may_proceed(slice);
+}
+
+InstructionApplicationResult ParkedInstructions::try_apply(
+        size_t key,
+        DenseSlice& slice,
+        LSInstruction& instruction,
         bool local_instructions,
         bool allow_twists,
         const Layout& layout,
-        Router& router,
-        std::optional<std::chrono::seconds> timeout,
-        DenseSliceVisitor slice_visitor,
-        LSInstructionVisitor instruction_visitor,
-        bool graceful,
-        DensePatchComputationResult& res)
+        Router& router)
 {
-    DenseSlice slice{layout, core_qubits};
-
-    std::unordered_map<dag::label_t, size_t> attempts_per_instruction;
-    auto increment_attempts = [&attempts_per_instruction](dag::label_t label)
-    {
-        if (!attempts_per_instruction.contains(label))
-            attempts_per_instruction[label] = 0;
-        attempts_per_instruction[label]++;
-    };
-
-    auto handle_followup_instructions = [&dag](dag::label_t instruction_label, std::vector<LSInstruction>&& followup_instructions)
+    if (auto it = parked_.find(key); it != parked_.end())
     {
-        if (!followup_instructions.empty())
-            {
-                dag::label_t new_head = dag.expand(instruction_label, std::move(followup_instructions), true);
-                dag.make_proximate(new_head);
-            }
-            else
-                dag.pop_head(instruction_label);
-    };
-
-
-    while (!dag.empty())
-    {
-        // Apply all proximate instructions
-        auto proximate_instructions = dag.proximate_instructions();
-        for (dag::label_t instruction_label: proximate_instructions)
+        if (!may_proceed(it->second, slice))
         {
-            LSInstruction& instruction = dag.at(instruction_label);
-            auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions, allow_twists, layout, router);
-            if (application_result.maybe_error)
-                throw std::runtime_error{lstk::cat(
-                    "Could not apply proximate instruction:\n",
-                    instruction,"\n",
-                    "Caused by:\n",
-                    application_result.maybe_error->what())};
-            else
-            {
-                res.ls_instructions_count_++;
-                instruction_visitor(instruction);
-            }
-            handle_followup_instructions(instruction_label, std::move(application_result.followup_instructions));
-            
+            // Woken for something that has since been taken again during the slice
+            if (it->second.woken)
+                index(key, it->second);
+            return {std::make_unique<std::runtime_error>(it->second.error), {}, it->second.wait_condition};
         }
+        parked_.erase(it);
+    }
 
-        // Now apply all non-proximate instructions, where possible
-        auto non_proximate_instructions = dag.applicable_instructions();
-        for (dag::label_t instruction_label: non_proximate_instructions)
-        {
-            LSInstruction& instruction = dag.at(instruction_label);
-            auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions, allow_twists, layout, router);
-            if (application_result.maybe_error)
-            {
-                increment_attempts(instruction_label);
-                if (attempts_per_instruction[instruction_label] > MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE)
-                {
-                    throw std::runtime_error{lstk::cat(
-                        "Could not apply non-proximate instruction after ",
-                        MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE," retries:\n",
-                        instruction,"\n",
-                        "Caused by:\n",
-                        application_result.maybe_error->what())};
-                }
-            }
-            else
-            {
-                res.ls_instructions_count_++;
-                instruction_visitor(instruction);
-                handle_followup_instructions(instruction_label, std::move(application_result.followup_instructions));
-            }
-        }
-
-        // Advance the slice
-        slice_visitor(slice);
-        advance_slice(slice, layout);
-        res.slice_count_++;
-
+    slice_changed_ = true;
+    auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions, allow_twists, layout, router);
+    if (application_result.maybe_error && application_result.followup_instructions.empty()
+        && !application_result.wait_condition.may_proceed(slice))
+    {
+        auto [parked, _] = parked_.emplace(key, ParkedInstruction{application_result.maybe_error->what(), application_result.wait_condition, 0});
+        index(key, parked->second);
     }
+    return application_result;
 }
 
-void run_through_dense_slices_wave(
+
+std::unique_ptr<SchedulerPolicy> make_scheduler_policy(
         LSInstructionStream&& instruction_stream,
+        PipelineMode pipeline_mode,
+        DagWindow dag_window,
+        std::optional<size_t> wave_window,
+        size_t lookahead_depth,
         bool local_instructions,
         bool allow_twists,
         const Layout& layout,
         Router& router,
-        std::optional<std::chrono::seconds> timeout,
+        InstructionOrdering instruction_ordering,
+        bool pauli_commutation,
+        WaveStatsVisitor wave_stats_visitor)
+{
+    switch (pipeline_mode)
+    {
+    case PipelineMode::Stream:
+        return std::make_unique<StreamSchedulerPolicy>(
+            std::move(instruction_stream), local_instructions, allow_twists, layout, router);
+
+    case PipelineMode::Dag:
+        return std::make_unique<DagSchedulerPolicy>(
+            std::move(instruction_stream), dag_window, local_instructions, allow_twists, layout, router,
+            instruction_ordering, pauli_commutation);
+
+    case PipelineMode::Wave:
+        return std::make_unique<WaveScheduler>(
+            std::move(instruction_stream), wave_window, local_instructions, allow_twists, layout,
+            router.local_routing_mode(), instruction_ordering, pauli_commutation, wave_stats_visitor);
+
+    case PipelineMode::Lookahead:
+        return std::make_unique<LookaheadSchedulerPolicy>(
+            std::move(instruction_stream), dag_window, lookahead_depth, local_instructions, allow_twists, layout, router,
+            instruction_ordering, pauli_commutation);
+
+    default: LSTK_UNREACHABLE;
+    }
+}
+
+void run_scheduler_policy(
+        SchedulerPolicy& scheduler_policy,
+        DenseSlice& slice,
+        const Layout& layout,
         DenseSliceVisitor slice_visitor,
+        DenseSliceRepeatVisitor slice_repeat_visitor,
         LSInstructionVisitor instruction_visitor,
-        bool graceful,
         DensePatchComputationResult& res)
 {
-    DenseSlice slice{layout, instruction_stream.core_qubits()};
-    WaveScheduler scheduler(std::move(instruction_stream), local_instructions, allow_twists, layout);
-    
-    while (!scheduler.done())
+    while (!scheduler_policy.done())
     {
-        scheduler.schedule_wave(slice, instruction_visitor, res);
-        
+        // When all that is left to do is wait for distillation, skip straight to the slice the next magic state is on
+        if (slice_repeat_visitor)
+        {
+            if (auto idle_slices = slices_until_magic_state(slice, layout))
+            {
+                if (auto idle_outcome = scheduler_policy.idle_outcome(slice, *idle_slices))
+                {
+                    scheduler_policy.skip_idle_slices(*idle_slices);
+                    slice_repeat_visitor(slice, *idle_slices);
+                    fast_forward_slice(slice, layout, *idle_slices);
+                    if (*idle_outcome == SliceOutcome::Complete)
+                        res.slice_count_ += *idle_slices;
+                    continue;
+                }
+            }
+        }
+
+        SliceOutcome outcome = scheduler_policy.schedule_slice(slice, instruction_visitor, res);
         slice_visitor(slice);
+        if (outcome == SliceOutcome::Drained)
+            break;
+
         advance_slice(slice, layout);
-        
-        res.slice_count_++;
+        if (outcome == SliceOutcome::Complete)
+            res.slice_count_++;
     }
 }
 
@@ -1000,14 +1211,22 @@ void run_through_dense_slices_wave(
 DensePatchComputationResult run_through_dense_slices(
         LSInstructionStream&& instruction_stream,
         PipelineMode pipeline_mode,
+        DagWindow dag_window,
+        std::optional<size_t> wave_window,
+        size_t lookahead_depth,
         bool local_instructions,
         bool allow_twists,
         const Layout& layout,
         Router& router,
+        InstructionOrdering instruction_ordering,
+        bool pauli_commutation,
         std::optional<std::chrono::seconds> timeout,
         DenseSliceVisitor slice_visitor,
+        DenseSliceRepeatVisitor slice_repeat_visitor,
         LSInstructionVisitor instruction_visitor,
-        bool graceful)
+        WaveStatsVisitor wave_stats_visitor,
+        bool graceful,
+        std::function<void()> on_halt)
 {
 
     DensePatchComputationResult res;
@@ -1017,7 +1236,7 @@ DensePatchComputationResult run_through_dense_slices(
     if(timeout.has_value())
     {
 
-        slice_visitor = [&, slice_visitor](const DenseSlice& slice)
+        auto check_timeout = [&]()
         {
             if (timeout && lstk::since(start)>*timeout)
             {
@@ -1027,59 +1246,40 @@ DensePatchComputationResult run_through_dense_slices(
 
                 throw std::runtime_error{timeout_str};
             }
+        };
+
+        slice_visitor = [check_timeout, slice_visitor](const DenseSlice& slice)
+        {
+            check_timeout();
             slice_visitor(slice);
         };
+        if (slice_repeat_visitor)
+        {
+            slice_repeat_visitor = [check_timeout, slice_repeat_visitor](const DenseSlice& slice, size_t repeats)
+            {
+                check_timeout();
+                slice_repeat_visitor(slice, repeats);
+            };
+        }
     }
 
     auto run = [&]()
     {
-        switch (pipeline_mode)
-        {
-        case PipelineMode::Stream:
-            return run_through_dense_slices_streamed(
-                std::move(instruction_stream),
-                local_instructions,
-                allow_twists,
-                layout,
-                router,
-                timeout,
-                slice_visitor,
-                instruction_visitor,
-                graceful,
-                res);
-        
-        case PipelineMode::Dag:
-        {
-            auto dag = dag::full_dependency_dag_from_instruction_stream(instruction_stream);
-            return run_through_dense_slices_dag(
-                std::move(dag),
-                instruction_stream.core_qubits(),
-                local_instructions,
-                allow_twists,
-                layout,
-                router,
-                timeout,
-                slice_visitor,
-                instruction_visitor,
-                graceful,
-                res);
-        }
-        
-        case PipelineMode::Wave:
-            return run_through_dense_slices_wave(
+        DenseSlice slice{layout, instruction_stream.core_qubits()};
+        auto scheduler_policy = make_scheduler_policy(
                 std::move(instruction_stream),
+                pipeline_mode,
+                dag_window,
+                wave_window,
+                lookahead_depth,
                 local_instructions,
                 allow_twists,
                 layout,
                 router,
-                timeout,
-                slice_visitor,
-                instruction_visitor,
-                graceful,
-                res);
-        
-        default: LSTK_UNREACHABLE;
-        }
+                instruction_ordering,
+                pauli_commutation,
+                wave_stats_visitor);
+        run_scheduler_policy(*scheduler_policy, slice, layout, slice_visitor, slice_repeat_visitor, instruction_visitor, res);
     };
 
     if(graceful)
@@ -1089,7 +1289,8 @@ DensePatchComputationResult run_through_dense_slices(
         }
         catch (const std::exception& e)
         {
-
+            if (on_halt)
+                on_halt();
             std::cout << "Encountered exception: " << e.what() << std::endl;
             std::cout << "Halting slicing" << std::endl;
         }
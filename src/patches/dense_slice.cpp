@@ -1,5 +1,7 @@
 #include <lsqecc/patches/dense_slice.hpp>
 
+#include <algorithm>
+
 namespace lsqecc
 {
 
@@ -237,5 +239,40 @@ SurfaceCodeTimestep DenseSlice::time_to_next_magic_state(size_t distillation_reg
     return time_to_next_magic_state_by_distillation_region[distillation_region_id];
 }
 
+std::optional<MagicStateArrival> DenseSlice::next_magic_state_arrival() const
+{
+    if (!magic_states.empty())
+        return MagicStateArrival{0, *magic_states.begin()};
+
+    // Reserved tiles are themselves the distillation regions, and their timers follow the same order
+    const Layout& layout_ref = layout.get();
+    std::optional<MagicStateArrival> next_arrival;
+    for (size_t i = 0; i < time_to_next_magic_state_by_distillation_region.size(); i++)
+    {
+        std::optional<Cell> cell;
+        if (layout_ref.magic_states_reserved())
+        {
+            if (i < layout_ref.reserved_for_magic_states().size())
+                cell = layout_ref.reserved_for_magic_states()[i];
+        }
+        else if (i < layout_ref.distillation_regions().size())
+        {
+            // The state goes to the first free location, as in advance_slice
+            const auto& locations = layout_ref.distilled_state_locations(i);
+            auto free_location = std::find_if(locations.begin(), locations.end(),
+                    [this](const Cell& location){ return is_cell_free(location); });
+            if (free_location != locations.end())
+                cell = *free_location;
+            else if (!locations.empty())
+                cell = locations.front();
+        }
+
+        SurfaceCodeTimestep steps = time_to_next_magic_state_by_distillation_region[i];
+        if (cell && (!next_arrival || steps < next_arrival->steps))
+            next_arrival = MagicStateArrival{steps, *cell};
+    }
+    return next_arrival;
+}
+
 }
 
@@ -0,0 +1,230 @@
+#include <lsqecc/patches/slice_binary.hpp>
+
+#include <lstk/lstk.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+
+namespace lsqecc {
+
+
+namespace {
+
+constexpr std::string_view k_magic = "LSQSLICE";
+
+constexpr uint32_t k_repeat_counts_flag = 1;
+
+template<class UInt>
+void append_little_endian(std::string& buffer, UInt value)
+{
+    for (size_t i = 0; i < sizeof(UInt); i++)
+        buffer.push_back(static_cast<char>((value >> (8*i)) & 0xff));
+}
+
+template<class UInt>
+UInt read_little_endian(const char* bytes)
+{
+    UInt value = 0;
+    for (size_t i = 0; i < sizeof(UInt); i++)
+        value |= static_cast<UInt>(static_cast<unsigned char>(bytes[i])) << (8*i);
+    return value;
+}
+
+template<class UInt>
+UInt read_little_endian(std::istream& is)
+{
+    char bytes[sizeof(UInt)];
+    if (!is.read(bytes, sizeof(UInt)))
+        throw std::runtime_error{"Slice file ends in its header"};
+    return read_little_endian<UInt>(bytes);
+}
+
+uint64_t encode_boundary(Boundary boundary)
+{
+    return static_cast<uint64_t>(boundary.boundary_type) | (boundary.is_active ? 0b100 : 0);
+}
+
+Boundary decode_boundary(uint64_t bits)
+{
+    return Boundary{static_cast<BoundaryType>(bits & 0b11), (bits & 0b100) != 0};
+}
+
+}
+
+
+size_t SliceBinaryHeader::cell_count() const
+{
+    return size_t(furthest_cell.row+1)*size_t(furthest_cell.col+1);
+}
+
+size_t SliceBinaryHeader::slice_size() const
+{
+    return (repeat_counts ? sizeof(uint32_t) : 0) + cell_count()*sizeof(uint64_t) + timer_cells.size()*sizeof(uint32_t);
+}
+
+
+SliceBinaryHeader slice_binary_header(const Layout& layout)
+{
+    SliceBinaryHeader header{layout.furthest_cell(), {}};
+    for(const MultipleCellsOccupiedByPatch& distillation_region: layout.distillation_regions())
+        header.timer_cells.push_back(distillation_region.sub_cells.front().cell);
+    return header;
+}
+
+
+void write_slice_binary_header(const SliceBinaryHeader& header, std::string& buffer)
+{
+    buffer.append(k_magic);
+    append_little_endian<uint32_t>(buffer, k_slice_binary_version);
+    append_little_endian<uint32_t>(buffer, header.repeat_counts ? k_repeat_counts_flag : 0);
+    append_little_endian<uint32_t>(buffer, uint32_t(header.furthest_cell.row+1));
+    append_little_endian<uint32_t>(buffer, uint32_t(header.furthest_cell.col+1));
+    append_little_endian<uint32_t>(buffer, uint32_t(header.timer_cells.size()));
+    for (const Cell& cell : header.timer_cells)
+    {
+        append_little_endian<uint32_t>(buffer, uint32_t(cell.row));
+        append_little_endian<uint32_t>(buffer, uint32_t(cell.col));
+    }
+}
+
+
+void write_slice_binary(const SliceBinaryHeader& header, const DenseSlice& slice, std::string& buffer, uint32_t repeats)
+{
+    buffer.reserve(buffer.size() + header.slice_size());
+    if (header.repeat_counts)
+        append_little_endian<uint32_t>(buffer, repeats);
+    for (Cell::CoordinateType row_idx = 0; row_idx<=header.furthest_cell.row; ++row_idx)
+        for (Cell::CoordinateType col_idx = 0; col_idx<=header.furthest_cell.col; ++col_idx)
+            append_little_endian(buffer, encode_slice_binary_cell(slice.cells[row_idx][col_idx]));
+    for (size_t distillation_region_id = 0; distillation_region_id < header.timer_cells.size(); distillation_region_id++)
+        append_little_endian<uint32_t>(buffer, slice.time_to_next_magic_state(distillation_region_id));
+}
+
+
+uint64_t encode_slice_binary_cell(const std::optional<DensePatch>& patch)
+{
+    if (!patch)
+        return 0;
+
+    uint64_t word = 1;
+    word |= static_cast<uint64_t>(patch->type) << 1;
+    word |= static_cast<uint64_t>(patch->activity) << 4;
+    word |= encode_boundary(patch->boundaries.top) << 7;
+    word |= encode_boundary(patch->boundaries.bottom) << 11;
+    word |= encode_boundary(patch->boundaries.left) << 15;
+    word |= encode_boundary(patch->boundaries.right) << 19;
+    if (patch->id)
+        word |= (uint64_t{1} << 23) | (static_cast<uint64_t>(*patch->id) << 32);
+    return word;
+}
+
+std::optional<DensePatch> decode_slice_binary_cell(uint64_t word)
+{
+    if (!(word & 1))
+        return std::nullopt;
+
+    uint64_t type = (word >> 1) & 0b111;
+    uint64_t activity = (word >> 4) & 0b111;
+    if (type > static_cast<uint64_t>(PatchType::Dead) || activity > static_cast<uint64_t>(PatchActivity::Rotation))
+        throw std::runtime_error{lstk::cat("Bad cell in slice file: ", word)};
+
+    DensePatch patch{
+        Patch{static_cast<PatchType>(type), static_cast<PatchActivity>(activity), std::nullopt},
+        CellBoundaries{
+            decode_boundary(word >> 7),
+            decode_boundary(word >> 11),
+            decode_boundary(word >> 15),
+            decode_boundary(word >> 19)}};
+    if (word & (uint64_t{1} << 23))
+        patch.id = static_cast<PatchId>(word >> 32);
+    return patch;
+}
+
+
+void pack_slice(const SliceBinaryHeader& header, const DenseSlice& slice, PackedSlice& packed)
+{
+    packed.cells.clear();
+    for (const DenseSlice::RowStore& row : slice.cells)
+        for (const std::optional<DensePatch>& patch : row)
+            packed.cells.push_back(encode_slice_binary_cell(patch));
+    packed.timers.clear();
+    for (size_t distillation_region_id = 0; distillation_region_id < header.timer_cells.size(); distillation_region_id++)
+        packed.timers.push_back(slice.time_to_next_magic_state(distillation_region_id));
+}
+
+void unpack_slice(const PackedSlice& packed, DenseSlice& slice)
+{
+    auto next_cell = packed.cells.begin();
+    for (DenseSlice::RowStore& row : slice.cells)
+        for (std::optional<DensePatch>& patch : row)
+            patch = decode_slice_binary_cell(*next_cell++);
+
+    auto& timers = slice.time_to_next_magic_state_by_distillation_region;
+    if (timers.size() < packed.timers.size())
+        timers.resize(packed.timers.size());
+    std::copy(packed.timers.begin(), packed.timers.end(), timers.begin());
+}
+
+
+SliceBinaryHeader read_slice_binary_header(std::istream& is)
+{
+    char magic[k_magic.size()];
+    if (!is.read(magic, k_magic.size()) || std::string_view{magic, k_magic.size()} != k_magic)
+        throw std::runtime_error{"Not a slice file"};
+    auto version = read_little_endian<uint32_t>(is);
+    if (version == 0 || version > k_slice_binary_version)
+        throw std::runtime_error{lstk::cat("Unsupported slice file version: ", version)};
+    uint32_t flags = version >= 2 ? read_little_endian<uint32_t>(is) : 0;
+
+    auto rows = read_little_endian<uint32_t>(is);
+    auto cols = read_little_endian<uint32_t>(is);
+    if (rows == 0 || cols == 0)
+        throw std::runtime_error{"Slice file has an empty layout"};
+    SliceBinaryHeader header{Cell::from_ints(rows-1, cols-1), {}, (flags & k_repeat_counts_flag) != 0};
+
+    auto distillation_region_count = read_little_endian<uint32_t>(is);
+    for (uint32_t i = 0; i < distillation_region_count; i++)
+    {
+        auto row = read_little_endian<uint32_t>(is);
+        auto col = read_little_endian<uint32_t>(is);
+        if (row >= rows || col >= cols)
+            throw std::runtime_error{"Slice file has a distillation timer outside the layout"};
+        header.timer_cells.push_back(Cell::from_ints(row, col));
+    }
+    return header;
+}
+
+
+bool read_slice_binary(
+        std::istream& is,
+        const SliceBinaryHeader& header,
+        std::vector<std::optional<DensePatch>>& cells,
+        std::vector<SurfaceCodeTimestep>& timers,
+        uint32_t& repeats)
+{
+    std::string bytes(header.slice_size(), '\0');
+    is.read(bytes.data(), std::streamsize(bytes.size()));
+    if (is.gcount() == 0)
+        return false;
+    if (size_t(is.gcount()) != bytes.size())
+        throw std::runtime_error{"Slice file ends part way through a slice"};
+
+    cells.clear();
+    timers.clear();
+    const char* next = bytes.data();
+    repeats = 1;
+    if (header.repeat_counts)
+    {
+        repeats = read_little_endian<uint32_t>(next);
+        next += sizeof(uint32_t);
+    }
+    for (size_t i = 0; i < header.cell_count(); i++, next += sizeof(uint64_t))
+        cells.push_back(decode_slice_binary_cell(read_little_endian<uint64_t>(next)));
+    for (size_t i = 0; i < header.timer_cells.size(); i++, next += sizeof(uint32_t))
+        timers.push_back(read_little_endian<uint32_t>(next));
+    return true;
+}
+
+}
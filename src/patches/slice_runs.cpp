@@ -0,0 +1,42 @@
+#include <lsqecc/patches/slice_runs.hpp>
+#include <lsqecc/patches/slice_binary.hpp>
+
+
+namespace lsqecc {
+
+
+SliceRunCollapser::SliceRunCollapser(RunWriter run_writer)
+    : run_writer_(std::move(run_writer))
+{}
+
+
+void SliceRunCollapser::visit(const DenseSlice& slice)
+{
+    cells_.clear();
+    for (const DenseSlice::RowStore& row : slice.cells)
+        for (const std::optional<DensePatch>& patch : row)
+            cells_.push_back(encode_slice_binary_cell(patch));
+
+    // Runs are counted in 32 bits in the binary format
+    if (run_length_ != 0 && cells_ == run_cells_ && run_length_ < UINT32_MAX)
+    {
+        run_length_++;
+        return;
+    }
+
+    flush();
+    run_slice_ = slice;
+    run_length_ = 1;
+    std::swap(run_cells_, cells_);
+}
+
+
+void SliceRunCollapser::flush()
+{
+    if (run_length_ == 0)
+        return;
+    run_writer_(*run_slice_, run_length_);
+    run_length_ = 0;
+}
+
+}
@@ -1,6 +1,9 @@
 
 #include <lsqecc/patches/slices_to_json.hpp>
 
+#include <charconv>
+#include <string_view>
+
 using namespace nlohmann;
 
 namespace lsqecc {
@@ -164,4 +167,274 @@ json slice_to_json(const SparseSlice& slice)
 
 
 
+namespace {
+
+// The pieces of a slice's JSON between the values that vary, in the key order nlohmann::json prints objects in
+struct SliceJsonFragments
+{
+    std::string slice_open;
+    std::string slice_close;
+    std::string row_open;
+    std::string row_close;
+    std::string separator;
+    std::string cell_indent;
+    std::string null_cell;
+    std::string cell_open; // Up to the activity type
+    std::string activity_to_bottom;
+    std::string bottom_to_left;
+    std::string left_to_right;
+    std::string right_to_top;
+    std::string top_to_patch_type;
+    std::string patch_type_to_text;
+    std::string text_only_cell_open;
+    std::string cell_close;
+
+    // Around a slice written with a repeat count, up to the count, after it and after the slice
+    std::string repeat_open;
+    std::string repeat_to_slice;
+    std::string repeat_close;
+};
+
+// As dump(3) indents a slice whose opening bracket is on a line indented by `indent`
+SliceJsonFragments make_indented_fragments(size_t indent)
+{
+    const std::string i0(indent, ' ');
+    const std::string i1(indent+3, ' ');
+    const std::string i2(indent+6, ' ');
+    const std::string i3(indent+9, ' ');
+    const std::string i4(indent+12, ' ');
+    return SliceJsonFragments{
+        "[\n",
+        "\n"+i0+"]",
+        i1+"[\n",
+        "\n"+i1+"]",
+        ",\n",
+        i2,
+        "null",
+        "{\n"+i3+"\"activity\": {\n"+i4+"\"activity_type\": ",
+        "\n"+i3+"},\n"+i3+"\"edges\": {\n"+i4+"\"Bottom\": \"",
+        "\",\n"+i4+"\"Left\": \"",
+        "\",\n"+i4+"\"Right\": \"",
+        "\",\n"+i4+"\"Top\": \"",
+        "\"\n"+i3+"},\n"+i3+"\"patch_type\": \"",
+        "\",\n"+i3+"\"text\": \"",
+        "{\n"+i3+"\"text\": \"",
+        "\"\n"+i2+"}",
+        "{\n"+i1+"\"repeat\": ",
+        ",\n"+i1+"\"slice\": ",
+        "\n"+i0+"}"
+    };
+}
+
+const SliceJsonFragments k_indented_fragments = make_indented_fragments(0);
+const SliceJsonFragments k_repeated_indented_fragments = make_indented_fragments(3);
+
+const SliceJsonFragments k_compact_fragments{
+    "[",
+    "]",
+    "[",
+    "]",
+    ",",
+    "",
+    "null",
+    "{\"activity\":{\"activity_type\":",
+    "},\"edges\":{\"Bottom\":\"",
+    "\",\"Left\":\"",
+    "\",\"Right\":\"",
+    "\",\"Top\":\"",
+    "\"},\"patch_type\":\"",
+    "\",\"text\":\"",
+    "{\"text\":\"",
+    "\"}",
+    "{\"repeat\":",
+    ",\"slice\":",
+    "}"
+};
+
+
+std::string_view edge_fragment(Boundary boundary)
+{
+    switch (boundary.boundary_type)
+    {
+    case BoundaryType::None:return "None";
+    case BoundaryType::Connected: return boundary.is_active ? "AncillaJoin": "None";
+    case BoundaryType::Rough:return boundary.is_active ? "DashedStiched": "Dashed";
+    case BoundaryType::Smooth: return boundary.is_active ? "SolidStiched": "Solid";
+    }
+    LSTK_UNREACHABLE;
+}
+
+std::string_view patch_type_fragment(PatchType type)
+{
+    switch (type)
+    {
+    case PatchType::Distillation: return "DistillationQubit";
+    case PatchType::PreparedState:return "DistillationQubit";
+    case PatchType::Qubit: return "Qubit";
+    case PatchType::Routing: return "Ancilla";
+    case PatchType::Dead: return "Ancilla";
+    }
+    LSTK_UNREACHABLE;
+}
+
+std::string_view activity_fragment(PatchActivity activity)
+{
+    switch (activity)
+    {
+    case PatchActivity::Measurement: return "\"Measurement\"";
+    case PatchActivity::Unitary: return "\"Unitary\"";
+    case PatchActivity::None: return "null";
+    case PatchActivity::Distillation: return "null";
+    case PatchActivity::Dead: return "null";
+    case PatchActivity::MultiPatchMeasurement: return "null";
+    case PatchActivity::Rotation: return "null";
+    }
+    LSTK_UNREACHABLE;
+}
+
+template<class Integer>
+void append_number(std::string& buffer, Integer number)
+{
+    char digits[24];
+    auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), number);
+    LSTK_UNUSED(ec);
+    buffer.append(digits, end);
+}
+
+}
+
+
+namespace {
+
+std::vector<Cell> timer_cells_of(const Layout& layout)
+{
+    std::vector<Cell> timer_cells;
+    for(const MultipleCellsOccupiedByPatch& distillation_region: layout.distillation_regions())
+        timer_cells.push_back(distillation_region.sub_cells.front().cell);
+    return timer_cells;
+}
+
+}
+
+
+SliceJsonWriter::SliceJsonWriter(const Layout& layout, bool compact)
+    : SliceJsonWriter(layout.furthest_cell(), timer_cells_of(layout), compact)
+{}
+
+
+SliceJsonWriter::SliceJsonWriter(Cell furthest_cell, const std::vector<Cell>& timer_cells, bool compact)
+    : compact_(compact),
+      furthest_cell_(furthest_cell),
+      timer_region_at_(size_t(furthest_cell_.row+1)*size_t(furthest_cell_.col+1))
+{
+    // Later regions overwrite earlier ones, as in annotate_time_to_next_distilled_state
+    for (size_t distillation_region_counter = 0; distillation_region_counter < timer_cells.size(); distillation_region_counter++)
+    {
+        const Cell& distillation_cell = timer_cells[distillation_region_counter];
+        timer_region_at_[size_t(distillation_cell.row)*size_t(furthest_cell_.col+1)+size_t(distillation_cell.col)]
+                = distillation_region_counter;
+    }
+}
+
+
+void SliceJsonWriter::write(const DenseSlice& slice, std::string& buffer, size_t repeats) const
+{
+    write_cells(buffer, repeats,
+            [&](Cell::CoordinateType row_idx, Cell::CoordinateType col_idx) -> const std::optional<DensePatch>& {
+                return slice.cells[row_idx][col_idx];
+            },
+            [&](size_t distillation_region_id){ return slice.time_to_next_magic_state(distillation_region_id); });
+}
+
+
+void SliceJsonWriter::write(
+        const std::vector<std::optional<DensePatch>>& cells,
+        const std::vector<SurfaceCodeTimestep>& timers,
+        std::string& buffer,
+        size_t repeats) const
+{
+    const size_t row_length = size_t(furthest_cell_.col+1);
+    write_cells(buffer, repeats,
+            [&](Cell::CoordinateType row_idx, Cell::CoordinateType col_idx) -> const std::optional<DensePatch>& {
+                return cells[size_t(row_idx)*row_length+size_t(col_idx)];
+            },
+            [&](size_t distillation_region_id){ return timers.at(distillation_region_id); });
+}
+
+
+template<class CellAt, class TimerOf>
+void SliceJsonWriter::write_cells(std::string& buffer, size_t repeats, CellAt cell_at, TimerOf time_to_next_magic_state) const
+{
+    const SliceJsonFragments& outer_fragments = compact_ ? k_compact_fragments : k_indented_fragments;
+    if (repeats != 1)
+    {
+        buffer.append(outer_fragments.repeat_open);
+        append_number(buffer, repeats);
+        buffer.append(outer_fragments.repeat_to_slice);
+    }
+    const SliceJsonFragments& fragments = compact_ || repeats == 1 ? outer_fragments : k_repeated_indented_fragments;
+
+    buffer.append(fragments.slice_open);
+    for (Cell::CoordinateType row_idx = 0; row_idx<=furthest_cell_.row; ++row_idx)
+    {
+        if (row_idx != 0)
+            buffer.append(fragments.separator);
+        buffer.append(fragments.row_open);
+        for (Cell::CoordinateType col_idx = 0; col_idx<=furthest_cell_.col; ++col_idx)
+        {
+            if (col_idx != 0)
+                buffer.append(fragments.separator);
+            buffer.append(fragments.cell_indent);
+
+            const std::optional<DensePatch>& p = cell_at(row_idx, col_idx);
+            const auto& timer_region = timer_region_at_[size_t(row_idx)*size_t(furthest_cell_.col+1)+size_t(col_idx)];
+            if (!p)
+            {
+                if (!timer_region)
+                {
+                    buffer.append(fragments.null_cell);
+                    continue;
+                }
+                buffer.append(fragments.text_only_cell_open);
+            }
+            else
+            {
+                buffer.append(fragments.cell_open);
+                buffer.append(activity_fragment(p->activity));
+                buffer.append(fragments.activity_to_bottom);
+                buffer.append(edge_fragment(p->boundaries.bottom));
+                buffer.append(fragments.bottom_to_left);
+                buffer.append(edge_fragment(p->boundaries.left));
+                buffer.append(fragments.left_to_right);
+                buffer.append(edge_fragment(p->boundaries.right));
+                buffer.append(fragments.right_to_top);
+                buffer.append(edge_fragment(p->boundaries.top));
+                buffer.append(fragments.top_to_patch_type);
+                buffer.append(patch_type_fragment(p->type));
+                buffer.append(fragments.patch_type_to_text);
+            }
+
+            if (timer_region)
+            {
+                buffer.append("Time to next magic state:");
+                append_number(buffer, time_to_next_magic_state(*timer_region));
+            }
+            else if (p->id)
+            {
+                buffer.append("Id: ");
+                append_number(buffer, *p->id);
+            }
+            else if ((p->type==PatchType::Distillation && p->activity == PatchActivity::None) ||  p->type ==PatchType::Qubit)
+                buffer.append("Not bound");
+            buffer.append(fragments.cell_close);
+        }
+        buffer.append(fragments.row_close);
+    }
+    buffer.append(fragments.slice_close);
+
+    if (repeats != 1)
+        buffer.append(outer_fragments.repeat_close);
+}
+
+
 }
\ No newline at end of file
@@ -0,0 +1,281 @@
+#include <lsqecc/pipelines/portfolio.hpp>
+#include <lsqecc/pipelines/slicer.hpp>
+
+#include <lstk/lstk.hpp>
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+
+namespace lsqecc
+{
+
+    namespace {
+
+        constexpr std::array<std::string_view, 4> k_pipelines = {"stream", "dag", "wave", "lookahead"};
+        constexpr std::array<std::string_view, 3> k_graph_searches = {"djikstra", "astar", "boost"};
+
+        // Options the portfolio sets for each candidate, or reads itself
+        constexpr std::array<std::string_view, 8> k_portfolio_options = {
+            "--portfolio", "--portfoliobudget", "-P", "--pipeline", "-g", "--graph-search", "-i", "--input"};
+
+        bool is_portfolio_option(std::string_view arg)
+        {
+            arg = arg.substr(0, arg.find('='));
+            return std::find(k_portfolio_options.begin(), k_portfolio_options.end(), arg) != k_portfolio_options.end();
+        }
+
+        std::vector<std::string> candidate_arguments(int argc, const char* argv[], const PortfolioCandidate& candidate)
+        {
+            std::vector<std::string> args{argv[0]};
+            for (int i = 1; i < argc; i++)
+            {
+                std::string_view arg{argv[i]};
+                if (!is_portfolio_option(arg))
+                {
+                    args.emplace_back(arg);
+                    continue;
+                }
+                // Skip the value too, unless it was given with '=' or left out
+                if (arg.find('=') == std::string_view::npos && i+1 < argc && argv[i+1][0] != '-')
+                    i++;
+            }
+
+            args.emplace_back("-P");
+            args.push_back(candidate.pipeline);
+            if (candidate.graph_search)
+            {
+                args.emplace_back("-g");
+                args.push_back(*candidate.graph_search);
+            }
+            return args;
+        }
+
+
+        // Thrown from a candidate's slice hook to stop it
+        struct CandidateStopped {};
+
+        // Keeps track of the best finished candidate, for the others to check against as they go
+        class PortfolioRace
+        {
+        public:
+            explicit PortfolioRace(size_t candidate_count) : running_(candidate_count) {}
+
+            // Whether a candidate that has made this many slices may still end up with fewer than the best, or as many
+            // but earlier in the list
+            bool can_still_win(size_t candidate_index, size_t slice_count)
+            {
+                std::lock_guard lock{mutex_};
+                if (out_of_budget_)
+                    return false;
+                if (!best_)
+                    return true;
+                return slice_count < best_->slice_count
+                       || (slice_count == best_->slice_count && candidate_index < best_->candidate_index);
+            }
+
+            void finish(size_t candidate_index, size_t slice_count)
+            {
+                std::lock_guard lock{mutex_};
+                if (!best_ || slice_count < best_->slice_count
+                    || (slice_count == best_->slice_count && candidate_index < best_->candidate_index))
+                    best_ = Result{candidate_index, slice_count};
+            }
+
+            void leave()
+            {
+                std::lock_guard lock{mutex_};
+                if (--running_ == 0)
+                    all_left_.notify_one();
+            }
+
+            void wait(std::optional<std::chrono::seconds> budget)
+            {
+                std::unique_lock lock{mutex_};
+                auto all_left = [this](){ return running_ == 0; };
+                if (!budget)
+                    all_left_.wait(lock, all_left);
+                else if (!all_left_.wait_for(lock, *budget, all_left))
+                    out_of_budget_ = true;
+            }
+
+            std::optional<size_t> winner()
+            {
+                std::lock_guard lock{mutex_};
+                if (!best_)
+                    return std::nullopt;
+                return best_->candidate_index;
+            }
+
+        private:
+            struct Result
+            {
+                size_t candidate_index;
+                size_t slice_count;
+            };
+
+            std::mutex mutex_;
+            std::condition_variable all_left_;
+            size_t running_;
+            bool out_of_budget_ = false;
+            std::optional<Result> best_;
+        };
+
+        struct CandidateRun
+        {
+            std::ostringstream output;
+            std::ostringstream bulk_output; // Only used with -o
+            std::ostringstream err;
+            size_t slice_count = 0;
+            bool finished = false;
+            bool stopped = false;
+        };
+
+    }
+
+
+    std::string PortfolioCandidate::name() const
+    {
+        return graph_search ? lstk::cat(pipeline, ":", *graph_search) : pipeline;
+    }
+
+    std::vector<PortfolioCandidate> parse_portfolio_candidates(std::string_view candidates)
+    {
+        // The wave pipeline always routes with A*, so it is tried once
+        if (candidates.empty())
+            return {{"stream", "djikstra"}, {"stream", "astar"}, {"dag", "djikstra"}, {"dag", "astar"}, {"wave", std::nullopt}};
+
+        std::vector<PortfolioCandidate> ret;
+        for (std::string_view candidate : lstk::split_on(candidates, ','))
+        {
+            auto parts = lstk::split_on(candidate, ':');
+            if (parts.size() > 2)
+                throw std::invalid_argument{lstk::cat("Bad portfolio candidate: ", candidate)};
+            if (std::find(k_pipelines.begin(), k_pipelines.end(), parts[0]) == k_pipelines.end())
+                throw std::invalid_argument{lstk::cat("Unknown portfolio pipeline: ", parts[0])};
+
+            PortfolioCandidate portfolio_candidate{std::string{parts[0]}, std::nullopt};
+            if (parts.size() > 1)
+            {
+                if (std::find(k_graph_searches.begin(), k_graph_searches.end(), parts[1]) == k_graph_searches.end())
+                    throw std::invalid_argument{lstk::cat("Unknown portfolio graph search: ", parts[1])};
+                portfolio_candidate.graph_search = std::string{parts[1]};
+            }
+            ret.push_back(std::move(portfolio_candidate));
+        }
+        return ret;
+    }
+
+    int run_portfolio(
+            int argc, const char* argv[],
+            const PortfolioOptions& options,
+            std::istream& in_stream,
+            std::ostream& out_stream,
+            std::ostream& err_stream)
+    {
+        std::stringstream input_buffer;
+        if (options.input_file)
+        {
+            std::ifstream input_file{*options.input_file};
+            if (input_file.fail())
+            {
+                err_stream << "Could not open instruction file: " << *options.input_file << std::endl;
+                return -1;
+            }
+            input_buffer << input_file.rdbuf();
+        }
+        else
+            input_buffer << in_stream.rdbuf();
+        const std::string input = input_buffer.str();
+
+        // Each candidate parses the input again rather than sharing the instructions, which are only read as slicing
+        // needs them. Settings a candidate makes while setting up, like the default CNOT ancilla placement, are kept
+        // per run or per thread, so candidates don't see each other's
+        PortfolioRace race{options.candidates.size()};
+        std::vector<std::unique_ptr<CandidateRun>> runs;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < options.candidates.size(); i++)
+            runs.push_back(std::make_unique<CandidateRun>());
+        for (size_t i = 0; i < options.candidates.size(); i++)
+        {
+            threads.emplace_back([&, i]()
+            {
+                CandidateRun& run = *runs[i];
+                std::vector<std::string> args = candidate_arguments(argc, argv, options.candidates[i]);
+                std::vector<const char*> c_args;
+                for (const auto& arg : args)
+                    c_args.push_back(arg.c_str());
+
+                SlicerHooks hooks;
+                if (options.output_file)
+                    hooks.bulk_output_stream = &run.bulk_output;
+                // Slices are counted as they are written out, so the stream pipeline's blocked slices count too
+                hooks.on_slice = [&](size_t slice_count)
+                {
+                    run.slice_count = slice_count;
+                    if (!race.can_still_win(i, slice_count))
+                        throw CandidateStopped{};
+                };
+
+                std::istringstream candidate_input{input};
+                try
+                {
+                    if (run_slicer_program(static_cast<int>(c_args.size()), c_args.data(), candidate_input, run.output, run.err, hooks) == 0)
+                    {
+                        run.finished = true;
+                        race.finish(i, run.slice_count);
+                    }
+                }
+                catch (const CandidateStopped&)
+                {
+                    run.stopped = true;
+                }
+                catch (const std::exception& e)
+                {
+                    run.err << e.what() << std::endl;
+                }
+                race.leave();
+            });
+        }
+
+        race.wait(options.budget);
+        for (auto& thread : threads)
+            thread.join();
+
+        for (size_t i = 0; i < options.candidates.size(); i++)
+        {
+            const CandidateRun& run = *runs[i];
+            err_stream << "Portfolio candidate " << options.candidates[i].name() << ": ";
+            if (run.finished)
+                err_stream << run.slice_count << " slices" << std::endl;
+            else if (run.stopped)
+                err_stream << "stopped after " << run.slice_count << " slices" << std::endl;
+            else
+                err_stream << "failed" << std::endl << run.err.str();
+        }
+
+        auto winner = race.winner();
+        if (!winner)
+        {
+            err_stream << "No portfolio candidate finished" << std::endl;
+            return -1;
+        }
+
+        const CandidateRun& best_run = *runs[*winner];
+        if (options.output_file)
+        {
+            std::ofstream output_file{*options.output_file};
+            output_file << best_run.bulk_output.str();
+        }
+        out_stream << best_run.output.str();
+        return 0;
+    }
+
+}
@@ -1,4 +1,5 @@
 #include <lsqecc/pipelines/slicer.hpp>
+#include <lsqecc/pipelines/portfolio.hpp>
 
 #include <lsqecc/dag/domain_dags.hpp>
 #include <lsqecc/gates/parse_gates.hpp>
@@ -12,10 +13,15 @@
 #include <lsqecc/layout/dynamic_layouts/compact_layout.hpp>
 #include <lsqecc/layout/dynamic_layouts/edpc_layout.hpp>
 #include <lsqecc/patches/slices_to_json.hpp>
+#include <lsqecc/patches/slice_binary.hpp>
+#include <lsqecc/patches/slice_runs.hpp>
+#include <lsqecc/patches/async_slice_writer.hpp>
 #include <lsqecc/patches/slice.hpp>
 #include <lsqecc/patches/slice_stats.hpp>
 #include <lsqecc/patches/dense_patch_computation.hpp>
 #include <lsqecc/patches/slice_variant.hpp>
+#include <lsqecc/scheduler/scheduler_policy.hpp>
+#include <lsqecc/scheduler/wave_scheduler.hpp>
 
 #include <lstk/lstk.hpp>
 
@@ -58,6 +64,11 @@ namespace lsqecc
         Progress, NoProgress, Machine, Stats
     };
 
+    enum class SliceFormat
+    {
+        Json, Binary
+    };
+
     enum class PrintDagMode {
         None, Input, ProcessedLli
      };
@@ -100,6 +111,16 @@ namespace lsqecc
             std::istream& in_stream,
             std::ostream& out_stream,
             std::ostream& err_stream)
+    {
+        return run_slicer_program(argc, argv, in_stream, out_stream, err_stream, SlicerHooks{});
+    }
+
+    int run_slicer_program(
+            int argc, const char* argv[],
+            std::istream& in_stream,
+            std::ostream& out_stream,
+            std::ostream& err_stream,
+            const SlicerHooks& hooks)
     {
         std::string prog_name{argv[0]};
         argparse::ArgumentParser parser(prog_name, "Slice LS-Instructions");
@@ -123,6 +144,10 @@ namespace lsqecc
                 .names({"-f", "--output-format"})
                 .description("Requires -o, STDOUT output format: progress, noprogress, machine, stats")
                 .required(false);
+        parser.add_argument()
+                .names({"--sliceformat"})
+                .description("Format the slices are written out in: json (default), binary (fixed size slices, turn into JSON with lsqecc_slice_convert)")
+                .required(false);
         parser.add_argument()
                 .names({"-t", "--timeout"})
                 .description("Set a timeout in seconds after which stop producing slices")
@@ -133,12 +158,48 @@ namespace lsqecc
                 .required(false);
         parser.add_argument()
                 .names({"-P", "--pipeline"})
-                .description("pipeline mode: stream (default), dag")
+                .description("pipeline mode: stream (default), dag, wave, lookahead (dag that packs the cheapest of the next ready instructions first)")
+                .required(false);
+        parser.add_argument()
+                .names({"--dagwindow"})
+                .description("Only compatible with -P dag and -P lookahead. Maximum number of pending instructions held in the dependency dag (default: whole input)")
+                .required(false);
+        parser.add_argument()
+                .names({"--dagmemory"})
+                .description("Only compatible with -P dag and -P lookahead. Approximate memory cap in MB for the dependency dag (default: unbounded)")
+                .required(false);
+        parser.add_argument()
+                .names({"--wavewindow"})
+                .description("Only compatible with -P wave. Maximum number of instructions waiting to complete in the scheduler, more are read as they complete (default: whole input)")
+                .required(false);
+        parser.add_argument()
+                .names({"--wavestats"})
+                .description("Only compatible with -P wave. File name to write per-wave scheduler stats to, as CSV")
+                .required(false);
+        parser.add_argument()
+                .names({"--paulicommutation"})
+                .description("Only compatible with -P dag, -P wave, -P lookahead and --printdag processedlli. Instructions acting on a common patch with the same Pauli operator, like two Z basis measurements, don't wait for each other")
+                .required(false);
+        parser.add_argument()
+                .names({"--lookaheaddepth"})
+                .description("Only compatible with -P lookahead. Number of ready instructions whose routing is evaluated before committing to a slice (default: 8)")
+                .required(false);
+        parser.add_argument()
+                .names({"--portfolio"})
+                .description("Slices with several pipeline[:graph search] candidates at once, each on a thread, and outputs the one with the fewest slices. Incompatible with -P, -g, --graceful, --printdag, --printlli before, --wavestats and --mapinput (default: stream:djikstra,stream:astar,dag:djikstra,dag:astar,wave)")
+                .required(false);
+        parser.add_argument()
+                .names({"--portfoliobudget"})
+                .description("Only compatible with --portfolio. Seconds after which candidates still slicing are stopped (default: no limit)")
                 .required(false);
         parser.add_argument()
                 .names({"-g", "--graph-search"})
                 .description("Set a graph search provider: djikstra (default), astar, boost (not always available)")
                 .required(false);
+        parser.add_argument()
+                .names({"--ordering"})
+                .description("Only compatible with -P dag, -P wave and -P lookahead. Order in which ready instructions are tried: fifo (default), criticalpath (longest remaining path first, weighted by duration and T count), distillation (magic state requests first, nearest to the next magic state first)")
+                .required(false);
         parser.add_argument()
                 .names({"--graceful"})
                 .description("If there is an error when slicing, print the error and terminate")
@@ -188,6 +249,26 @@ namespace lsqecc
                              "negative power of ten of this value (I.e. precision=10^(-rzprecision)). Defaults to 10.")
                 .required(false);
         #endif // USE_GRIDSYNTH
+        parser.add_argument()
+                .names({"--asyncoutput"})
+                .description("Experimental, has not been seen to pay off yet. Write the slices out on a thread of their own while slicing goes on. Slicing waits when this many slices (at least 1) are waiting to be written out")
+                .required(false);
+        parser.add_argument()
+                .names({"--outputthreads"})
+                .description("Requires --asyncoutput. Serialize this many slices at once, each on a thread of its own (default 1). The output is the same as with one")
+                .required(false);
+        parser.add_argument()
+                .names({"--repeatslices"})
+                .description("Write a run of slices with the same cells once, with how many slices it lasted (in JSON as {\"repeat\": n, \"slice\": ...}). Only the first slice's distillation timers are kept")
+                .required(false);
+        parser.add_argument()
+                .names({"--compactjson"})
+                .description("Write the slices' JSON without indentation")
+                .required(false);
+        parser.add_argument()
+                .names({"--mapinput"})
+                .description("Requires an LLI file given with -i. Memory map the file and parse the instructions in place, instead of reading it line by line")
+                .required(false);
         parser.add_argument()
                 .names({"--nostagger"})
                 .description("Turns off staggered distillation block timing")
@@ -200,6 +281,10 @@ namespace lsqecc
                 .names({"--local"})
                 .description("Compile gates using a local lattice surgery instruction set")
                 .required(false);
+        parser.add_argument()
+                .names({"--localrouting"})
+                .description("Only compatible with --local. Route choice for Bell based instructions: shortest (default), parity (fewest local instruction steps, allows detours)")
+                .required(false);
         parser.add_argument()
                 .names({"--notwists"})
                 .description("Compile S gates using twist-based Y state initialization (Gidney, 2024)")
@@ -219,6 +304,45 @@ namespace lsqecc
             return 0;
         }
 
+        if (parser.exists("portfoliobudget") && !parser.exists("portfolio"))
+        {
+            err_stream << "--portfoliobudget requires --portfolio" << std::endl;
+            return -1;
+        }
+        if (parser.exists("portfolio"))
+        {
+            if (parser.exists("pipeline") || parser.exists("g"))
+            {
+                err_stream << "--portfolio sets -P and -g for each candidate" << std::endl;
+                return -1;
+            }
+            // Candidates read the input from memory, so there is no file for --mapinput to map
+            if (parser.exists("graceful") || parser.exists("printdag") || parser.exists("wavestats") || parser.exists("mapinput")
+                || (parser.exists("printlli") && parser.get<std::string>("printlli") != "sliced"))
+            {
+                err_stream << "--portfolio is incompatible with --graceful, --printdag, --printlli before, --wavestats and --mapinput" << std::endl;
+                return -1;
+            }
+
+            PortfolioOptions portfolio_options;
+            try
+            {
+                portfolio_options.candidates = parse_portfolio_candidates(parser.get<std::string>("portfolio"));
+            }
+            catch (const std::invalid_argument& e)
+            {
+                err_stream << e.what() << std::endl;
+                return -1;
+            }
+            if (parser.exists("portfoliobudget"))
+                portfolio_options.budget = std::chrono::seconds{parser.get<uint32_t>("portfoliobudget")};
+            if (parser.exists("i"))
+                portfolio_options.input_file = parser.get<std::string>("i");
+            if (parser.exists("o"))
+                portfolio_options.output_file = parser.get<std::string>("o");
+            return run_portfolio(argc, argv, portfolio_options, in_stream, out_stream, err_stream);
+        }
+
         DistillationOptions distillation_options = make_distillation_options(parser);
 
         LayoutMode layout_mode = AutoLayoutMode::Compact;
@@ -247,11 +371,35 @@ namespace lsqecc
             // Default to Litinsiki's compact layout
         }
 
+        SliceFormat slice_format = SliceFormat::Json;
+        if(parser.exists("sliceformat"))
+        {
+            auto format_arg = parser.get<std::string>("sliceformat");
+            if (format_arg=="json")
+                slice_format = SliceFormat::Json;
+            else if (format_arg=="binary")
+                slice_format = SliceFormat::Binary;
+            else
+            {
+                err_stream << "Unknown slice format " << format_arg << std::endl;
+                return -1;
+            }
+
+            if(slice_format == SliceFormat::Binary && parser.exists("compactjson"))
+            {
+                err_stream << "--compactjson is incompatible with --sliceformat binary" << std::endl;
+                return -1;
+            }
+        }
+
         std::reference_wrapper<std::ostream> bulk_output_stream = std::ref(out_stream);
         std::unique_ptr<std::ostream> _ofstream_store;
-        if(parser.exists("o"))
+        if(hooks.bulk_output_stream)
+            bulk_output_stream = std::ref(*hooks.bulk_output_stream);
+        else if(parser.exists("o"))
         {
-            _ofstream_store = std::make_unique<std::ofstream>(parser.get<std::string>("o"));
+            auto open_mode = slice_format == SliceFormat::Binary ? std::ios::out | std::ios::binary : std::ios::out;
+            _ofstream_store = std::make_unique<std::ofstream>(parser.get<std::string>("o"), open_mode);
             bulk_output_stream = std::ref(*_ofstream_store);
         }
 
@@ -306,6 +454,8 @@ namespace lsqecc
                 pipeline_mode = PipelineMode::Dag;
             else if (mode_arg=="wave")
                 pipeline_mode = PipelineMode::Wave;
+            else if (mode_arg=="lookahead")
+                pipeline_mode = PipelineMode::Lookahead;
             else
             {
                 err_stream << "Unknown pipeline mode " << mode_arg << std::endl;
@@ -314,6 +464,74 @@ namespace lsqecc
         }
 
 
+        DagWindow dag_window;
+        if (parser.exists("dagwindow"))
+        {
+            if (pipeline_mode != PipelineMode::Dag && pipeline_mode != PipelineMode::Lookahead)
+            {
+                err_stream << "--dagwindow requires -P dag or -P lookahead" << std::endl;
+                return -1;
+            }
+            dag_window.max_instructions = parser.get<size_t>("dagwindow");
+        }
+        if (parser.exists("dagmemory"))
+        {
+            if (pipeline_mode != PipelineMode::Dag && pipeline_mode != PipelineMode::Lookahead)
+            {
+                err_stream << "--dagmemory requires -P dag or -P lookahead" << std::endl;
+                return -1;
+            }
+            dag_window.max_memory_bytes = parser.get<size_t>("dagmemory") * 1024 * 1024;
+        }
+
+        std::optional<size_t> wave_window;
+        if (parser.exists("wavewindow"))
+        {
+            if (pipeline_mode != PipelineMode::Wave)
+            {
+                err_stream << "--wavewindow requires -P wave" << std::endl;
+                return -1;
+            }
+            wave_window = parser.get<size_t>("wavewindow");
+        }
+
+
+        std::unique_ptr<std::ofstream> wave_stats_stream;
+        if (parser.exists("wavestats"))
+        {
+            if (pipeline_mode != PipelineMode::Wave)
+            {
+                err_stream << "--wavestats requires -P wave" << std::endl;
+                return -1;
+            }
+            wave_stats_stream = std::make_unique<std::ofstream>(parser.get<std::string>("wavestats"));
+            if (wave_stats_stream->fail())
+            {
+                err_stream << "Could not open wave stats file: " << parser.get<std::string>("wavestats") << std::endl;
+                return -1;
+            }
+            print_wave_stats_csv_header(*wave_stats_stream);
+        }
+
+        bool pauli_commutation = parser.exists("paulicommutation");
+        if (pauli_commutation && pipeline_mode == PipelineMode::Stream && print_dag_mode != PrintDagMode::ProcessedLli)
+        {
+            err_stream << "--paulicommutation requires -P dag, -P wave, -P lookahead or --printdag processedlli" << std::endl;
+            return -1;
+        }
+
+        size_t lookahead_depth = DEFAULT_SCHEDULER_LOOKAHEAD_DEPTH;
+        if (parser.exists("lookaheaddepth"))
+        {
+            if (pipeline_mode != PipelineMode::Lookahead)
+            {
+                err_stream << "--lookaheaddepth requires -P lookahead" << std::endl;
+                return -1;
+            }
+            lookahead_depth = parser.get<size_t>("lookaheaddepth");
+        }
+
+
         std::reference_wrapper<std::istream> input_file_stream = std::ref(in_stream);
         std::unique_ptr<std::ifstream> _file_to_read_store;
         if(parser.exists("i"))
@@ -325,6 +543,11 @@ namespace lsqecc
             }
             input_file_stream = std::ref(*_file_to_read_store);
         }
+        if(parser.exists("mapinput") && (!parser.exists("i") || parser.exists("q")))
+        {
+            err_stream << "--mapinput requires an LLI file given with -i" << std::endl;
+            return -1;
+        }
 
         IdGenerator id_generator;
         std::unique_ptr<LSInstructionStream> instruction_stream;
@@ -340,12 +563,15 @@ namespace lsqecc
 
         if(!parser.exists("q"))
         {
-            instruction_stream = std::make_unique<LSInstructionStreamFromFile>(input_file_stream.get());
+            if(parser.exists("mapinput"))
+                instruction_stream = std::make_unique<LSInstructionStreamFromMappedFile>(parser.get<std::string>("i"));
+            else
+                instruction_stream = std::make_unique<LSInstructionStreamFromFile>(input_file_stream.get());
             id_generator.set_start(*std::max(instruction_stream->core_qubits().begin(),
                                              instruction_stream->core_qubits().end()));
             if( print_dag_mode == PrintDagMode::Input )
             {
-                auto dag = dag::full_dependency_dag_from_instruction_stream(*instruction_stream);
+                auto dag = dag::full_dependency_dag_from_instruction_stream(*instruction_stream, pauli_commutation);
                 dag.to_graphviz(out_stream);
                 return 0;
             }
@@ -478,7 +704,7 @@ namespace lsqecc
             return 0;
         } else if (print_dag_mode == PrintDagMode::ProcessedLli)
         {
-            auto dag = dag::full_dependency_dag_from_instruction_stream(*instruction_stream);
+            auto dag = dag::full_dependency_dag_from_instruction_stream(*instruction_stream, pauli_commutation);
             dag.to_graphviz(out_stream);
             return 0;
         }
@@ -520,23 +746,135 @@ namespace lsqecc
             }
         }
 
+        InstructionOrdering instruction_ordering = InstructionOrdering::Fifo;
+        if(parser.exists("ordering"))
+        {
+            if(pipeline_mode == PipelineMode::Stream)
+            {
+                err_stream << "--ordering requires -P dag, -P wave or -P lookahead" << std::endl;
+                return -1;
+            }
+            auto ordering_name = parser.get<std::string>("ordering");
+            if(ordering_name == "fifo")
+                instruction_ordering = InstructionOrdering::Fifo;
+            else if(ordering_name == "criticalpath")
+                instruction_ordering = InstructionOrdering::CriticalPath;
+            else if(ordering_name == "distillation")
+                instruction_ordering = InstructionOrdering::Distillation;
+            else
+            {
+                err_stream<<"Unknown ordering: "<< ordering_name <<std::endl;
+                return -1;
+            }
+        }
+
+        if(parser.exists("localrouting"))
+        {
+            if(!parser.exists("local"))
+            {
+                err_stream << "--localrouting requires --local" << std::endl;
+                return -1;
+            }
+            auto local_routing_name = parser.get<std::string>("localrouting");
+            if(local_routing_name == "shortest")
+                router->set_local_routing_mode(LocalRoutingMode::ShortestPath);
+            else if(local_routing_name == "parity")
+                router->set_local_routing_mode(LocalRoutingMode::ParityAware);
+            else
+            {
+                err_stream<<"Unknown local routing: "<< local_routing_name <<std::endl;
+                return -1;
+            }
+        }
+
 
         bool print_slices = !parser.exists("noslices") && lli_print_mode == LLIPrintMode::None;
         DenseSliceVisitor slice_visitor = [](const DenseSlice& s) -> void {LSTK_UNUSED(s);};
+        // Printed slices show the distillation timers, so only without them can repeated slices be visited at once
+        DenseSliceRepeatVisitor slice_repeat_visitor;
+        if(!print_slices)
+            slice_repeat_visitor = [](const DenseSlice& s, size_t repeats) -> void {LSTK_UNUSED(s); LSTK_UNUSED(repeats);};
         bool is_first_slice = true;
-        if(print_slices)
+        SliceJsonWriter slice_json_writer{*layout, parser.exists("compactjson")};
+        SliceBinaryHeader binary_header = slice_binary_header(*layout);
+        binary_header.repeat_counts = parser.exists("repeatslices");
+        std::string slice_buffer;
+        // Serializing a slice is kept apart from writing it out, so that slices can be serialized on several threads
+        AsyncSliceWriter::SliceSerializer serialize_slice;
+        AsyncSliceWriter::SerializedSliceWriter write_serialized_slice;
+        if(print_slices && slice_format == SliceFormat::Json)
         {
-            slice_visitor = [&bulk_output_stream, &is_first_slice](const DenseSlice & s){
+            serialize_slice = [&slice_json_writer](const DenseSlice & s, size_t repeats, std::string& buffer){
+                slice_json_writer.write(s, buffer, repeats);
+            };
+            write_serialized_slice = [&bulk_output_stream, &is_first_slice](const std::string& buffer){
+                bulk_output_stream.get() << (is_first_slice ? "[\n" : ",\n");
+                bulk_output_stream.get().write(buffer.data(), std::streamsize(buffer.size()));
                 if(is_first_slice)
-                {
-                    bulk_output_stream.get() << "[\n" << slice_to_json(s).dump(3);
                     is_first_slice = false;
-                }
                 else
-                    bulk_output_stream.get() << ",\n" << slice_to_json(s).dump(3) << std::flush;
+                    bulk_output_stream.get() << std::flush;
+            };
+        }
+        else if(print_slices && slice_format == SliceFormat::Binary)
+        {
+            slice_buffer.clear();
+            write_slice_binary_header(binary_header, slice_buffer);
+            bulk_output_stream.get().write(slice_buffer.data(), std::streamsize(slice_buffer.size()));
+            serialize_slice = [&binary_header](const DenseSlice & s, size_t repeats, std::string& buffer){
+                write_slice_binary(binary_header, s, buffer, uint32_t(repeats));
+            };
+            write_serialized_slice = [&bulk_output_stream](const std::string& buffer){
+                bulk_output_stream.get().write(buffer.data(), std::streamsize(buffer.size()));
             };
         }
 
+        SliceRunCollapser::RunWriter write_slice;
+        if(print_slices)
+        {
+            write_slice = [&serialize_slice, &write_serialized_slice, &slice_buffer](const DenseSlice & s, size_t repeats){
+                slice_buffer.clear();
+                serialize_slice(s, repeats, slice_buffer);
+                write_serialized_slice(slice_buffer);
+            };
+        }
+
+        if(parser.exists("outputthreads") && !parser.exists("asyncoutput"))
+        {
+            err_stream << "--outputthreads requires --asyncoutput" << std::endl;
+            return -1;
+        }
+        std::unique_ptr<AsyncSliceWriter> async_slice_writer;
+        if(parser.exists("asyncoutput"))
+        {
+            if(!print_slices)
+            {
+                err_stream << "--asyncoutput requires the slices to be written out" << std::endl;
+                return -1;
+            }
+            size_t output_capacity = parser.get<size_t>("asyncoutput");
+            if(output_capacity == 0)
+            {
+                err_stream << "--asyncoutput must be at least 1" << std::endl;
+                return -1;
+            }
+            size_t output_threads = parser.exists("outputthreads") ? parser.get<size_t>("outputthreads") : 1;
+            if(output_threads == 0)
+            {
+                err_stream << "--outputthreads must be at least 1" << std::endl;
+                return -1;
+            }
+            async_slice_writer = std::make_unique<AsyncSliceWriter>(
+                    *layout, output_capacity, output_threads, serialize_slice, write_serialized_slice);
+            write_slice = [&async_slice_writer](const DenseSlice & s, size_t repeats){ async_slice_writer->push(s, repeats); };
+        }
+
+        SliceRunCollapser slice_run_collapser{write_slice};
+        if(write_slice && parser.exists("repeatslices"))
+            slice_visitor = [&slice_run_collapser](const DenseSlice & s){ slice_run_collapser.visit(s); };
+        else if(write_slice)
+            slice_visitor = [&write_slice](const DenseSlice & s){ write_slice(s, 1); };
+
         size_t slice_counter = 0;
 
         auto gave_update_at = lstk::now();
@@ -552,6 +890,14 @@ namespace lsqecc
                     gave_update_at = std::chrono::steady_clock::now();
                 }
             };
+            if(slice_repeat_visitor)
+            {
+                slice_repeat_visitor = [&, slice_repeat_visitor](const DenseSlice & s, size_t repeats)
+                {
+                    slice_repeat_visitor(s, repeats);
+                    slice_counter += repeats;
+                };
+            }
         }
 
 
@@ -563,6 +909,16 @@ namespace lsqecc
                 slice_visitor(s);
                 slice_stats.totals += compute_volume_counts(s);
             };
+            if(slice_repeat_visitor)
+            {
+                slice_repeat_visitor = [&, slice_repeat_visitor](const DenseSlice & s, size_t repeats)
+                {
+                    slice_repeat_visitor(s, repeats);
+                    auto counts = compute_volume_counts(s);
+                    for (size_t i = 0; i < repeats; i++)
+                        slice_stats.totals += counts;
+                };
+            }
         }
 
         LSInstructionVisitor instruction_visitor{[&](const LSInstruction& i){}};
@@ -578,6 +934,47 @@ namespace lsqecc
                 slice_visitor(s);
                 bulk_output_stream.get() << std::endl;
             };
+            if(slice_repeat_visitor)
+            {
+                slice_repeat_visitor = [&, slice_repeat_visitor](const DenseSlice & s, size_t repeats)
+                {
+                    slice_repeat_visitor(s, repeats);
+                    for (size_t i = 0; i < repeats; i++)
+                        bulk_output_stream.get() << std::endl;
+                };
+            }
+        }
+
+
+        WaveStatsVisitor wave_stats_visitor;
+        size_t wave_counter = 0;
+        if (wave_stats_stream)
+        {
+            wave_stats_visitor = [&](const WaveStats& wave_stats)
+            {
+                print_wave_stats_csv(*wave_stats_stream, wave_counter, wave_stats);
+                wave_counter += wave_stats.repeats;
+            };
+        }
+
+
+        size_t hooked_slice_count = 0;
+        if (hooks.on_slice)
+        {
+            slice_visitor = [&, slice_visitor](const DenseSlice & s)
+            {
+                slice_visitor(s);
+                hooks.on_slice(++hooked_slice_count);
+            };
+            if(slice_repeat_visitor)
+            {
+                slice_repeat_visitor = [&, slice_repeat_visitor](const DenseSlice & s, size_t repeats)
+                {
+                    slice_repeat_visitor(s, repeats);
+                    hooked_slice_count += repeats;
+                    hooks.on_slice(hooked_slice_count);
+                };
+            }
         }
 
 
@@ -587,14 +984,23 @@ namespace lsqecc
             std::make_unique<DensePatchComputationResult>(run_through_dense_slices(
                     std::move(*instruction_stream),
                     pipeline_mode,
+                    dag_window,
+                    wave_window,
+                    lookahead_depth,
                     compile_mode == CompilationMode::Local,
                     sgate_mode == SGateMode::Twists,
                     *layout,
                     *router,
+                    instruction_ordering,
+                    pauli_commutation,
                     timeout,
                     slice_visitor,
+                    slice_repeat_visitor,
                     instruction_visitor,
-                    parser.exists("graceful")
+                    wave_stats_visitor,
+                    parser.exists("graceful"),
+                    // Writes out the run held back, so that it comes before the error
+                    [&](){ if(print_slices) slice_run_collapser.flush(); }
         ));
 
         if(parser.exists("o") || parser.exists("noslices"))
@@ -617,7 +1023,13 @@ namespace lsqecc
         }
         
         if(print_slices)
+            slice_run_collapser.flush();
+        if(async_slice_writer)
+            async_slice_writer->finish();
+        if(print_slices && slice_format == SliceFormat::Json)
             bulk_output_stream.get() << "]" <<std::endl;
+        if(print_slices && slice_format == SliceFormat::Binary)
+            bulk_output_stream.get() << std::flush;
         if (lli_print_mode == LLIPrintMode::Sliced)
             bulk_output_stream.get() << std::endl;
 
@@ -0,0 +1,301 @@
+#include <lsqecc/scheduler/scheduler_policy.hpp>
+
+#include <algorithm>
+
+
+namespace lsqecc {
+
+
+StreamSchedulerPolicy::StreamSchedulerPolicy(LSInstructionStream&& stream, bool local_instructions, bool allow_twists, const Layout& layout, Router& router):
+    stream_(stream),
+    local_instructions_(local_instructions),
+    allow_twists_(allow_twists),
+    layout_(layout),
+    router_(router)
+{}
+
+SliceOutcome StreamSchedulerPolicy::schedule_slice(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
+{
+    if (fatal_error_)
+        throw std::runtime_error{*fatal_error_};
+
+    parked_instructions_.wake(slice);
+    while (stream_.has_next_instruction() || !future_instructions_.empty())
+    {
+        LSInstruction instruction = [&]()
+        {
+            if (!future_instructions_.empty())
+                return lstk::deque_pop(future_instructions_);
+            res.ls_instructions_count_++;
+            return stream_.get_next_instruction();
+        }();
+
+        // Only the instruction at the front can have failed before
+        auto application_result = parked_instructions_.try_apply(0, slice, instruction, local_instructions_, allow_twists_, layout_, router_);
+        if (!application_result.maybe_error)
+            instruction_visitor(instruction);
+
+        if (!application_result.followup_instructions.empty())
+        {
+            for (auto&& i: application_result.followup_instructions)
+                future_instructions_.push_back(i);
+            return SliceOutcome::Complete;
+        }
+        else if (application_result.maybe_error)
+        {
+            if (instruction.wait_at_most_for == 0)
+                fatal_error_ = application_result.maybe_error->what();
+            else
+            {
+                instruction.wait_at_most_for--;
+                future_instructions_.push_front(instruction);
+            }
+            return SliceOutcome::Blocked;
+        }
+    }
+
+    drained_ = true;
+    return SliceOutcome::Drained;
+}
+
+std::optional<SliceOutcome> StreamSchedulerPolicy::idle_outcome(const DenseSlice& slice, size_t slices) const
+{
+    // Only the front instruction is tried, and it must not run out of retries meanwhile
+    if (fatal_error_ || future_instructions_.empty()
+        || !parked_instructions_.waiting_on_magic_state(0, slice)
+        || future_instructions_.front().wait_at_most_for < slices)
+        return std::nullopt;
+    return SliceOutcome::Blocked;
+}
+
+void StreamSchedulerPolicy::skip_idle_slices(size_t slices)
+{
+    future_instructions_.front().wait_at_most_for -= slices;
+}
+
+
+DagSchedulerPolicy::DagSchedulerPolicy(LSInstructionStream&& stream, DagWindow dag_window, bool local_instructions, bool allow_twists, const Layout& layout, Router& router, InstructionOrdering instruction_ordering, bool pauli_commutation):
+    local_instructions_(local_instructions),
+    allow_twists_(allow_twists),
+    layout_(layout),
+    router_(router),
+    dag_builder_(dag::ResourceAccessTrait<LSInstruction>{pauli_commutation}),
+    dag_(dag_builder_.dag()),
+    stream_(stream),
+    dag_window_(dag_window),
+    instruction_ordering_(instruction_ordering)
+{
+    const auto& distillation_times = layout.distillation_times();
+    size_t longest_distillation_time = distillation_times.empty()
+            ? 1 : *std::max_element(distillation_times.begin(), distillation_times.end());
+    max_slices_without_magic_state_ = MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE * std::max<size_t>(longest_distillation_time, 1);
+
+    fill_window();
+}
+
+void DagSchedulerPolicy::fill_window()
+{
+    bool pushed = false;
+    while (stream_.has_next_instruction()
+           && (dag_.empty() || dag_window_.has_room(dag_.size(), dag_builder_.approximate_memory_bytes())))
+    {
+        dag_builder_.push_instruction(stream_.get_next_instruction());
+        pushed = true;
+    }
+    if (pushed && instruction_ordering_ == InstructionOrdering::CriticalPath)
+        priorities_ = dag_.remaining_critical_path(critical_path_weight);
+}
+
+void DagSchedulerPolicy::handle_followup_instructions(dag::label_t instruction_label, std::vector<LSInstruction>&& followup_instructions)
+{
+    if (!followup_instructions.empty())
+    {
+        size_t followup_count = followup_instructions.size();
+        dag::label_t new_head = dag_builder_.expand(instruction_label, std::move(followup_instructions), true);
+        if (auto it = priorities_.find(instruction_label); it != priorities_.end())
+        {
+            // Followups take the place of the instruction on its paths
+            size_t priority = it->second;
+            priorities_.erase(it);
+            for (size_t i = 0; i < followup_count; i++)
+                priorities_[new_head + i] = priority;
+        }
+        dag_.make_proximate(new_head);
+    }
+    else
+    {
+        dag_builder_.pop_head(instruction_label);
+        priorities_.erase(instruction_label);
+    }
+}
+
+void DagSchedulerPolicy::order_ready_instructions(const DenseSlice& slice, std::vector<dag::label_t>& ready_instructions)
+{
+    switch (instruction_ordering_)
+    {
+    case InstructionOrdering::Fifo:
+        return;
+
+    case InstructionOrdering::CriticalPath:
+        std::stable_sort(ready_instructions.begin(), ready_instructions.end(), [this](dag::label_t lhs, dag::label_t rhs)
+        {
+            auto priority = [this](dag::label_t label)
+            {
+                auto it = priorities_.find(label);
+                return it != priorities_.end() ? it->second : 0;
+            };
+            return priority(lhs) > priority(rhs);
+        });
+        return;
+
+    case InstructionOrdering::Distillation:
+        order_by_magic_state_proximity(slice, ready_instructions, [this](dag::label_t label) -> const LSInstruction&
+        {
+            return dag_.at(label);
+        });
+        return;
+    }
+}
+
+SliceOutcome DagSchedulerPolicy::schedule_slice(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
+{
+    bool magic_state_available = !slice.magic_states.empty();
+
+    // Apply all proximate instructions
+    auto proximate_instructions = dag_.proximate_instructions();
+
+    for (dag::label_t instruction_label: proximate_instructions)
+    {
+        LSInstruction& instruction = dag_.at(instruction_label);
+        auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions_, allow_twists_, layout_, router_);
+        if (application_result.maybe_error)
+            throw std::runtime_error{lstk::cat(
+                "Could not apply proximate instruction:\n",
+                instruction,"\n",
+                "Caused by:\n",
+                application_result.maybe_error->what())};
+        else
+        {
+            res.ls_instructions_count_++;
+            instruction_visitor(instruction);
+        }
+        handle_followup_instructions(instruction_label, std::move(application_result.followup_instructions));
+    }
+
+    // Now apply all non-proximate instructions, where possible
+    parked_instructions_.wake(slice);
+    auto non_proximate_instructions = dag_.applicable_instructions();
+    order_ready_instructions(slice, non_proximate_instructions);
+    std::optional<dag::label_t> waiting_on_magic_state;
+    for (dag::label_t instruction_label: non_proximate_instructions)
+    {
+        LSInstruction& instruction = dag_.at(instruction_label);
+        auto application_result = parked_instructions_.try_apply(instruction_label, slice, instruction, local_instructions_, allow_twists_, layout_, router_);
+        if (application_result.maybe_error)
+        {
+            // Waiting on distillation is not a retry, however long distillation takes
+            if (application_result.wait_condition.reason == WaitCondition::Reason::MagicStateUnavailable)
+            {
+                if (!waiting_on_magic_state)
+                    waiting_on_magic_state = instruction_label;
+                continue;
+            }
+            if (++attempts_per_instruction_[instruction_label] > MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE)
+            {
+                throw std::runtime_error{lstk::cat(
+                    "Could not apply non-proximate instruction after ",
+                    MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE," retries:\n",
+                    instruction,"\n",
+                    "Caused by:\n",
+                    application_result.maybe_error->what())};
+            }
+        }
+        else
+        {
+            res.ls_instructions_count_++;
+            instruction_visitor(instruction);
+            handle_followup_instructions(instruction_label, std::move(application_result.followup_instructions));
+        }
+    }
+
+    if (!waiting_on_magic_state || magic_state_available)
+        slices_without_magic_state_ = 0;
+    else if (++slices_without_magic_state_ > max_slices_without_magic_state_)
+        throw std::runtime_error{lstk::cat(
+            "Could not get a magic state for ",max_slices_without_magic_state_," slices in a row, waiting on:\n",
+            dag_.at(*waiting_on_magic_state))};
+
+    fill_window();
+    return SliceOutcome::Complete;
+}
+
+std::optional<SliceOutcome> DagSchedulerPolicy::idle_outcome(const DenseSlice& slice, size_t slices) const
+{
+    // Leaves the last slice before giving up on a magic state to schedule_slice
+    if (slices_without_magic_state_ + slices >= max_slices_without_magic_state_)
+        return std::nullopt;
+    if (!dag_.proximate_instructions().empty())
+        return std::nullopt;
+    auto ready_instructions = dag_.applicable_instructions();
+    if (ready_instructions.empty())
+        return std::nullopt;
+    for (dag::label_t instruction_label: ready_instructions)
+        if (!parked_instructions_.waiting_on_magic_state(instruction_label, slice))
+            return std::nullopt;
+    return SliceOutcome::Complete;
+}
+
+void DagSchedulerPolicy::skip_idle_slices(size_t slices)
+{
+    slices_without_magic_state_ += slices;
+}
+
+
+LookaheadSchedulerPolicy::LookaheadSchedulerPolicy(LSInstructionStream&& stream, DagWindow dag_window, size_t depth, bool local_instructions, bool allow_twists, const Layout& layout, Router& router, InstructionOrdering instruction_ordering, bool pauli_commutation):
+    DagSchedulerPolicy(std::move(stream), dag_window, local_instructions, allow_twists, layout, router, instruction_ordering, pauli_commutation),
+    depth_(depth)
+{}
+
+std::optional<size_t> LookaheadSchedulerPolicy::routing_demand(const DenseSlice& slice, dag::label_t instruction_label)
+{
+    if (parked_instructions_.waiting(instruction_label, slice))
+        return std::nullopt;
+
+    // Both are copied, as applying an instruction may also record its progress on it
+    DenseSlice trial_slice{slice};
+    LSInstruction trial_instruction{dag_.at(instruction_label)};
+    auto application_result = try_apply_instruction_direct_followup(trial_slice, trial_instruction, local_instructions_, allow_twists_, layout_, router_);
+    if (application_result.maybe_error)
+        return std::nullopt;
+
+    // A cell is claimed if it was free and is now occupied, or held an idle patch that is now active
+    size_t claimed_cells = 0;
+    slice.traverse_cells([&](const Cell& cell, const std::optional<DensePatch>& before)
+    {
+        const auto& after = trial_slice.patch_at(cell);
+        if (after && (!before || (!before->is_active() && after->is_active())))
+            claimed_cells++;
+    });
+    return claimed_cells;
+}
+
+void LookaheadSchedulerPolicy::order_ready_instructions(const DenseSlice& slice, std::vector<dag::label_t>& ready_instructions)
+{
+    DagSchedulerPolicy::order_ready_instructions(slice, ready_instructions);
+
+    size_t depth = std::min(depth_, ready_instructions.size());
+    std::unordered_map<dag::label_t, std::optional<size_t>> demands;
+    for (size_t i = 0; i < depth; i++)
+        demands[ready_instructions[i]] = routing_demand(slice, ready_instructions[i]);
+
+    std::stable_sort(ready_instructions.begin(), ready_instructions.begin()+depth, [&demands](dag::label_t lhs, dag::label_t rhs)
+    {
+        const auto& lhs_demand = demands[lhs];
+        const auto& rhs_demand = demands[rhs];
+        if (lhs_demand && rhs_demand)
+            return *lhs_demand < *rhs_demand;
+        return lhs_demand.has_value() && !rhs_demand.has_value();
+    });
+}
+
+}
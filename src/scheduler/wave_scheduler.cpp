@@ -3,69 +3,297 @@
 #include <algorithm>
 #include <cassert>
 #include <unordered_map>
+#include <utility>
 
 
 namespace lsqecc {
 
 
-WaveScheduler::WaveScheduler(LSInstructionStream&& stream, bool local_instructions, bool allow_twists, const Layout& layout):
+std::ostream& print_wave_stats_csv_header(std::ostream& os)
+{
+	return os << "wave,repeats,wave_size,applied,proximate_heads,ready_heads,retried,rescheduled_self,"
+	          << "magic_states_consumed,routing_cells_change,routing_us,wave_us\n";
+}
+
+std::ostream& print_wave_stats_csv(std::ostream& os, size_t wave_index, const WaveStats& wave_stats)
+{
+	return os << wave_index << ','
+	          << wave_stats.repeats << ','
+	          << wave_stats.wave_size << ','
+	          << wave_stats.applied_wave_size << ','
+	          << wave_stats.proximate_heads << ','
+	          << wave_stats.ready_heads << ','
+	          << wave_stats.retried << ','
+	          << wave_stats.rescheduled_self << ','
+	          << wave_stats.magic_states_consumed << ','
+	          << wave_stats.routing_cells_change << ','
+	          << wave_stats.routing_time.count() << ','
+	          << wave_stats.wave_time.count() << '\n';
+}
+
+namespace {
+
+size_t count_routing_cells(const DenseSlice& slice)
+{
+	size_t routing_cells = 0;
+	slice.traverse_cells([&](const Cell& cell, const std::optional<DensePatch>& patch)
+	{
+		LSTK_UNUSED(cell);
+		if (patch && patch->type == PatchType::Routing)
+			++routing_cells;
+	});
+	return routing_cells;
+}
+
+}
+
+
+WaveScheduler::WaveScheduler(LSInstructionStream&& stream, std::optional<size_t> window, bool local_instructions, bool allow_twists, const Layout& layout, LocalRoutingMode local_routing_mode, InstructionOrdering instruction_ordering, bool pauli_commutation, WaveStatsVisitor wave_stats_visitor):
 	local_instructions_(local_instructions),
 	allow_twists_(allow_twists),
-	layout_(layout)
+	layout_(layout),
+	instruction_ordering_(instruction_ordering),
+	patch_access_{pauli_commutation},
+	wave_stats_visitor_(std::move(wave_stats_visitor)),
+	stream_(stream),
+	window_(window)
 {
-	router_.set_graph_search_provider(GraphSearchProvider::AStar);
+	timed_router_.set_graph_search_provider(GraphSearchProvider::AStar);
+	timed_router_.set_local_routing_mode(local_routing_mode);
 	
-	std::unordered_map<PatchId, InstructionID> patch_id_to_last_instruction;
+	ingest_instructions();
+	if (instruction_ordering_ == InstructionOrdering::CriticalPath)
+		compute_priorities();
+}
+
+size_t WaveScheduler::ingest_instructions()
+{
+	size_t ingested_count = 0;
 	
-	while (stream.has_next_instruction())
+	while (stream_.has_next_instruction() && (live_records_ == 0 || !window_ || live_records_ < *window_))
 	{
-		auto instruction = stream.get_next_instruction();
-		InstructionID instruction_id = uint32_t(records_.size());
-		assert(records_.size() < UINT32_MAX);
-		records_.push_back({instruction, {}});
-		
-		auto operating_patches = instruction.get_patch_dependencies();
-		assert(operating_patches.size() <= UINT8_MAX);
-		
-		uint8_t dependency_count = 0;
+		InstructionID instruction_id = allocate_record(stream_.get_next_instruction(), NO_INSTRUCTION);
+		++ingested_count;
 		
-		bool is_head = true;
+		uint32_t dependency_count = 0;
+		auto depend_on = [&](InstructionID pending_instruction_id)
+		{
+			++dependency_count;
+			records_[pending_instruction_id].dependents.push_back(instruction_id);
+		};
 		
-		for (auto patch_id : operating_patches) {
-			auto p = patch_id_to_last_instruction.try_emplace(patch_id, 0);
-			auto& last_instruction_on_patch = p.first->second;
-			
-			if (!p.second) // there was a previous instruction on this patch
+		patch_access_.for_each_access(records_[instruction_id].instruction,
+			[&](PatchId patch_id, bool shared, size_t share_group = 0)
+		{
+			PatchFrontier& frontier = patch_frontiers_[patch_id];
+			if (shared)
 			{
-				++dependency_count;
-				records_[last_instruction_on_patch].dependents.push_back(instruction_id);
-				is_head = false;
+				// Sharing in another group waits for the current group as a whole
+				if (!frontier.shared_since_barrier.empty() && frontier.share_group != share_group)
+					frontier.barrier = std::exchange(frontier.shared_since_barrier, {});
+				for (auto pending_instruction_id : frontier.barrier)
+					depend_on(pending_instruction_id);
+				frontier.shared_since_barrier.push_back(instruction_id);
+				frontier.share_group = share_group;
 			}
-			
-			last_instruction_on_patch = instruction_id;
-		}
+			else
+			{
+				for (auto pending_instruction_id : frontier.shared_since_barrier.empty() ? frontier.barrier : frontier.shared_since_barrier)
+					depend_on(pending_instruction_id);
+				frontier.shared_since_barrier.clear();
+				frontier.barrier.assign(1, instruction_id);
+			}
+		});
 		
-		dependency_counts_.push_back(dependency_count);
+		dependency_counts_[instruction_id] = dependency_count;
 		
-		if (is_head)
+		if (dependency_count == 0)
 		{
 			current_wave_.heads.push_back(instruction_id);	
 		}
 	}
+	
+	return ingested_count;
+}
+
+WaveScheduler::InstructionID WaveScheduler::allocate_record(LSInstruction&& instruction, InstructionID parent)
+{
+	++live_records_;
+	
+	if (!free_records_.empty())
+	{
+		InstructionID instruction_id = free_records_.back();
+		free_records_.pop_back();
+		
+		auto& record = records_[instruction_id];
+		record.instruction = std::move(instruction);
+		record.parent = parent;
+		record.pending_followups = 0;
+		record.live = true;
+		dependency_counts_[instruction_id] = 0;
+		return instruction_id;
+	}
+	
+	InstructionID instruction_id = uint32_t(records_.size());
+	assert(records_.size() < NO_INSTRUCTION);
+	records_.push_back({std::move(instruction), {}, parent});
+	dependency_counts_.push_back(0);
+	return instruction_id;
+}
+
+void WaveScheduler::release_record(InstructionID instruction_id)
+{
+	auto& record = records_[instruction_id];
+	
+	// Later instructions on these patches no longer have to wait for this one
+	if (record.parent == NO_INSTRUCTION)
+		for (auto patch_id : record.instruction.get_patch_dependencies())
+		{
+			auto it = patch_frontiers_.find(patch_id);
+			if (it == patch_frontiers_.end())
+				continue;
+			std::erase(it->second.barrier, instruction_id);
+			std::erase(it->second.shared_since_barrier, instruction_id);
+			if (it->second.barrier.empty() && it->second.shared_since_barrier.empty())
+				patch_frontiers_.erase(it);
+		}
+	
+	record.live = false;
+	record.dependents.clear();
+	free_records_.push_back(instruction_id);
+	--live_records_;
+}
+
+void WaveScheduler::compute_priorities()
+{
+	// Depth first over the dependents, with an explicit stack as dependency chains can be as long as the input
+	priorities_.assign(records_.size(), 0);
+	std::vector<bool> computed(records_.size(), false);
+	std::vector<std::pair<InstructionID, size_t>> stack; // record and index of the next dependent to visit
+	
+	for (InstructionID root = 0; root < records_.size(); ++root)
+	{
+		if (computed[root] || !records_[root].live || records_[root].parent != NO_INSTRUCTION)
+			continue;
+		
+		stack.push_back({root, 0});
+		while (!stack.empty())
+		{
+			auto [instruction_id, next_dependent] = stack.back();
+			const auto& dependents = records_[instruction_id].dependents;
+			if (next_dependent < dependents.size())
+			{
+				++stack.back().second;
+				if (!computed[dependents[next_dependent]])
+					stack.push_back({dependents[next_dependent], 0});
+				continue;
+			}
+			
+			size_t longest_dependent_path = 0;
+			for (size_t i = 0; i < dependents.size(); ++i)
+				longest_dependent_path = std::max(longest_dependent_path, priorities_[dependents[i]]);
+			priorities_[instruction_id] = critical_path_weight(records_[instruction_id].instruction) + longest_dependent_path;
+			computed[instruction_id] = true;
+			stack.pop_back();
+		}
+	}
+}
+
+size_t WaveScheduler::priority(InstructionID instruction_id) const
+{
+	// Followups take the place of the instruction they were expanded from on its paths
+	while (records_[instruction_id].parent != NO_INSTRUCTION)
+		instruction_id = records_[instruction_id].parent;
+	return priorities_[instruction_id];
 }
 	
 WaveStats WaveScheduler::schedule_wave(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
 {
+	wave_stats_ = WaveStats{};
+	auto start = lstk::now();
+	size_t routing_cells_before = wave_stats_visitor_ ? count_routing_cells(slice) : 0;
+	timed_router_.take_routing_time();
+	size_t magic_states_before = slice.magic_states.size();
+	
+	if (ingest_instructions() > 0 && instruction_ordering_ == InstructionOrdering::CriticalPath)
+		compute_priorities();
+	
+	if (instruction_ordering_ == InstructionOrdering::CriticalPath)
+		std::stable_sort(current_wave_.heads.begin(), current_wave_.heads.end(), [this](InstructionID lhs, InstructionID rhs)
+		{
+			return priority(lhs) > priority(rhs);
+		});
+	else if (instruction_ordering_ == InstructionOrdering::Distillation)
+		order_by_magic_state_proximity(slice, current_wave_.heads, [this](InstructionID instruction_id) -> const LSInstruction&
+		{
+			return records_[instruction_id].instruction;
+		});
+	
+	wave_stats_.proximate_heads = current_wave_.proximate_heads_.size();
+	wave_stats_.ready_heads = current_wave_.heads.size();
+	
 	size_t applied_count = 0;
 	applied_count += schedule_instructions(current_wave_.proximate_heads_, slice, instruction_visitor, res, true);
+	parked_instructions_.wake(slice);
 	applied_count += schedule_instructions(current_wave_.heads, slice, instruction_visitor, res, false);
 	
-	WaveStats wave_stats = { .wave_size = current_wave_.size(), .applied_wave_size = applied_count };
+	wave_stats_.wave_size = current_wave_.size();
+	wave_stats_.applied_wave_size = applied_count;
+	wave_stats_.magic_states_consumed = magic_states_before - slice.magic_states.size();
+	
+	if (wave_stats_visitor_)
+	{
+		wave_stats_.routing_cells_change = static_cast<std::ptrdiff_t>(count_routing_cells(slice)) - static_cast<std::ptrdiff_t>(routing_cells_before);
+		wave_stats_.routing_time = std::chrono::duration_cast<std::chrono::microseconds>(timed_router_.take_routing_time());
+		wave_stats_.wave_time = lstk::since<std::chrono::microseconds>(start);
+		wave_stats_visitor_(wave_stats_);
+	}
 	
 	std::swap(current_wave_, next_wave_);
     next_wave_.clear();
     
-    return wave_stats;
+    return wave_stats_;
+}
+
+SliceOutcome WaveScheduler::schedule_slice(DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
+{
+	schedule_wave(slice, instruction_visitor, res);
+	return SliceOutcome::Complete;
+}
+
+std::optional<SliceOutcome> WaveScheduler::idle_outcome(const DenseSlice& slice, size_t slices) const
+{
+	if (!current_wave_.proximate_heads_.empty() || current_wave_.heads.empty())
+		return std::nullopt;
+	
+	// The next wave would read more of the stream
+	if (stream_.has_next_instruction() && (live_records_ == 0 || !window_ || live_records_ < *window_))
+		return std::nullopt;
+	
+	for (auto instruction_id : current_wave_.heads)
+	{
+		if (!parked_instructions_.waiting_on_magic_state(instruction_id, slice)
+		    || records_[instruction_id].instruction.wait_at_most_for < slices)
+			return std::nullopt;
+	}
+	return SliceOutcome::Complete;
+}
+
+void WaveScheduler::skip_idle_slices(size_t slices)
+{
+	for (auto instruction_id : current_wave_.heads)
+		records_[instruction_id].instruction.wait_at_most_for -= slices;
+	
+	if (wave_stats_visitor_)
+	{
+		size_t waiting_heads = current_wave_.heads.size();
+		wave_stats_visitor_(WaveStats{
+			.wave_size = waiting_heads,
+			.applied_wave_size = 0,
+			.ready_heads = waiting_heads,
+			.retried = waiting_heads,
+			.repeats = slices});
+	}
 }
 
 size_t WaveScheduler::schedule_instructions(const std::vector<InstructionID>& instruction_ids, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res, bool proximate)
@@ -77,7 +305,7 @@ size_t WaveScheduler::schedule_instructions(const std::vector<InstructionID>& in
 		assert(dependency_counts_[instruction_id] == 0);
 		
 		auto& instruction = records_[instruction_id].instruction;
-		auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions_, allow_twists_, layout_, router_);
+		auto application_result = parked_instructions_.try_apply(instruction_id, slice, instruction, local_instructions_, allow_twists_, layout_, timed_router_);
 		
 		if (!application_result.maybe_error)
 		{   
@@ -85,10 +313,7 @@ size_t WaveScheduler::schedule_instructions(const std::vector<InstructionID>& in
 		    ++res.ls_instructions_count_;
 		    instruction_visitor(instruction);
 
-			if (application_result.followup_instructions.size() == 1 && application_result.followup_instructions[0] == instruction) // instruction has rescheduled itself
-				next_wave_.proximate_heads_.push_back(instruction_id);
-			else
-				schedule_dependent_instructions(instruction_id, application_result.followup_instructions, slice, instruction_visitor, res);
+			handle_applied_instruction(instruction_id, std::move(application_result.followup_instructions), slice, instruction_visitor, res);
 		}
 		else
 		{
@@ -107,6 +332,7 @@ size_t WaveScheduler::schedule_instructions(const std::vector<InstructionID>& in
 	                application_result.maybe_error->what())};
 		    
 		    --instruction.wait_at_most_for;
+		    ++wave_stats_.retried;
 		    next_wave_.heads.push_back(instruction_id);
 		}
 	}
@@ -114,45 +340,62 @@ size_t WaveScheduler::schedule_instructions(const std::vector<InstructionID>& in
 	return applied_count;
 }
 	
-void WaveScheduler::schedule_dependent_instructions(InstructionID instruction_id, const std::vector<LSInstruction>& followup_instructions, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
+void WaveScheduler::handle_applied_instruction(InstructionID instruction_id, std::vector<LSInstruction>&& followup_instructions, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
 {
-	auto& dependents = records_[instruction_id].dependents;
-	
-	if (followup_instructions.empty())
+	if (followup_instructions.size() == 1 && followup_instructions[0] == records_[instruction_id].instruction) // instruction has rescheduled itself
 	{
-		for (auto dependent : dependents)
-		{
-			assert(dependency_counts_[dependent] > 0);
-			--dependency_counts_[dependent];
-			if (dependency_counts_[dependent] == 0)
-			{
-				if (!try_schedule_immediately(dependent, slice, instruction_visitor, res))
-					next_wave_.heads.push_back(dependent);
-			}
-		}
+		++wave_stats_.rescheduled_self;
+		next_wave_.proximate_heads_.push_back(instruction_id);
 	}
 	else
+		schedule_dependent_instructions(instruction_id, std::move(followup_instructions), slice, instruction_visitor, res);
+}
+
+void WaveScheduler::schedule_dependent_instructions(InstructionID instruction_id, std::vector<LSInstruction>&& followup_instructions, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
+{
+	if (followup_instructions.empty())
+	{
+		complete_instruction(instruction_id, slice, instruction_visitor, res);
+		return;
+	}
+	
+	// Set before any followup gets to complete, so that the instruction only completes with the last one
+	records_[instruction_id].pending_followups = uint32_t(followup_instructions.size());
+	
+	for (auto&& followup : followup_instructions)
+	{
+		auto followup_id = allocate_record(std::move(followup), instruction_id);
+		
+		if (!try_schedule_immediately(followup_id, slice, instruction_visitor, res))
+			next_wave_.proximate_heads_.push_back(followup_id);
+	}
+}
+
+void WaveScheduler::complete_instruction(InstructionID instruction_id, DenseSlice& slice, LSInstructionVisitor instruction_visitor, DensePatchComputationResult& res)
+{
+	if (auto parent = records_[instruction_id].parent; parent != NO_INSTRUCTION)
+	{
+		release_record(instruction_id);
+		assert(records_[parent].pending_followups > 0);
+		if (--records_[parent].pending_followups == 0)
+			complete_instruction(parent, slice, instruction_visitor, res);
+		return;
+	}
+	
+	// Taken out before the record is released, as scheduling the dependents can reuse it
+	DependentList dependents = std::move(records_[instruction_id].dependents);
+	release_record(instruction_id);
+	
+	for (size_t i = 0; i < dependents.size(); ++i)
 	{
-		auto dependency_delta = followup_instructions.size() - 1;
-		if (dependency_delta != 0)
+		auto dependent = dependents[i];
+		assert(dependency_counts_[dependent] > 0);
+		--dependency_counts_[dependent];
+		if (dependency_counts_[dependent] == 0)
 		{
-			for (auto dependent : dependents)
-			{
-				assert(dependency_counts_[dependent] + dependency_delta <= UINT8_MAX);
-				dependency_counts_[dependent] += dependency_delta;
-			}
+			if (!try_schedule_immediately(dependent, slice, instruction_visitor, res))
+				next_wave_.heads.push_back(dependent);
 		}
-		
-	    for (auto&& followup : followup_instructions)
-	    {
-	    	auto followup_id = records_.size();
-	    	assert(records_.size() < UINT32_MAX);
-	    	records_.push_back({followup, dependents});
-	    	dependency_counts_.push_back(0);
-	    	
-	    	if (!try_schedule_immediately(followup_id, slice, instruction_visitor, res))
-	    		next_wave_.proximate_heads_.push_back(followup_id);
-	    }
 	}
 }
 	
@@ -201,7 +444,7 @@ bool WaveScheduler::try_schedule_immediately(InstructionID instruction_id, Dense
 	if (!is_immediate(instruction))
 		return false;
 	
-	auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions_, allow_twists_, layout_, router_);
+	auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions_, allow_twists_, layout_, timed_router_);
 	
 	if (application_result.maybe_error)
 		return false;
@@ -210,11 +453,7 @@ bool WaveScheduler::try_schedule_immediately(InstructionID instruction_id, Dense
 		++res.ls_instructions_count_;
 		instruction_visitor(instruction);
 		
-		if (application_result.followup_instructions.size() == 1 && application_result.followup_instructions[0] == instruction) // instruction has rescheduled itself
-			next_wave_.proximate_heads_.push_back(instruction_id);
-		else
-			schedule_dependent_instructions(instruction_id, application_result.followup_instructions, slice, instruction_visitor, res);
-		
+		handle_applied_instruction(instruction_id, std::move(application_result.followup_instructions), slice, instruction_visitor, res);
 		return true;
 	}
 }
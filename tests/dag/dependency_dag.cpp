@@ -24,6 +24,17 @@ struct CommutationTrait<TestInstruction> {
         return lhs.interdependency_group != rhs.interdependency_group;
     }
 };
+
+template<>
+struct ResourceAccessTrait<TestInstruction> {
+    using Resource = int;
+
+    template<typename F>
+    static void for_each_access(const TestInstruction& instruction, F&& f)
+    {
+        f(instruction.interdependency_group, false);
+    }
+};
 } // namespace lsqecc::dag
 
 TEST(dependency_dag, generate)
@@ -72,6 +83,89 @@ TEST(dependency_dag, generate_2)
     ASSERT_EQ(ss.str(), to_graphviz(dag));
 }
 
+TEST(dependency_dag, incremental_builder_leaves_out_transitive_edges)
+{
+    DependencyDag<TestInstruction> full_dag;
+    IncrementalDependencyDagBuilder<TestInstruction> builder;
+    for (const TestInstruction& instruction : std::vector<TestInstruction>{{"A", 0}, {"B", 1}, {"C", 0}, {"D", 0}})
+    {
+        full_dag.push_instruction_based_on_commutation(TestInstruction{instruction});
+        builder.push_instruction(TestInstruction{instruction});
+    }
+    DependencyDag<TestInstruction> dag = builder.release();
+
+    ASSERT_TRUE(get_edges_for_testing(get_graph_for_testing(full_dag)).at(0).contains(3));
+
+    std::stringstream ss;
+    ss << "digraph DirectedGraph {" << std::endl;
+    ss << "  0 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>A 0</b></td></tr><tr><td><font color=\"darkgray\">node: 0</font></td></tr></table>>];" << std::endl;
+    ss << "  1 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>B 1</b></td></tr><tr><td><font color=\"darkgray\">node: 1</font></td></tr></table>>];" << std::endl;
+    ss << "  2 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>C 0</b></td></tr><tr><td><font color=\"darkgray\">node: 2</font></td></tr></table>>];" << std::endl;
+    ss << "  3 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>D 0</b></td></tr><tr><td><font color=\"darkgray\">node: 3</font></td></tr></table>>];" << std::endl;
+    ss << "  0 -> 2;" << std::endl;
+    ss << "  2 -> 3;" << std::endl;
+    ss << "}" << std::endl;
+
+    ASSERT_EQ(ss.str(), to_graphviz(dag));
+    ASSERT_EQ(full_dag.applicable_instructions(), dag.applicable_instructions());
+}
+
+TEST(dependency_dag, incremental_builder_streaming)
+{
+    IncrementalDependencyDagBuilder<TestInstruction> builder;
+    auto& dag = builder.dag();
+    builder.push_instruction({"A", 0});
+    builder.push_instruction({"B", 1});
+    builder.pop_head(0);
+
+    // A has left the dag, so C only waits on nothing
+    label_t c = builder.push_instruction({"C", 0});
+    ASSERT_EQ(dag.applicable_instructions(), (std::vector<label_t>{1, c}));
+
+    // After expanding B, later instructions on group 1 depend on the end of the replacement
+    label_t e = builder.expand(1, {{"E", 1}, {"F", 1}}, true);
+    label_t g = builder.push_instruction({"G", 1});
+    ASSERT_EQ(dag.size(), 4);
+    builder.pop_head(e);
+    builder.pop_head(c);
+    ASSERT_EQ(dag.applicable_instructions(), (std::vector<label_t>{e+1}));
+    builder.pop_head(e+1);
+    ASSERT_EQ(dag.applicable_instructions(), (std::vector<label_t>{g}));
+}
+
+TEST(dependency_dag, incremental_builder_drops_frontiers_of_popped_instructions)
+{
+    IncrementalDependencyDagBuilder<TestInstruction> builder;
+    size_t empty_memory = builder.approximate_memory_bytes();
+
+    // Each instruction on a resource of its own, like ancillas
+    for (int resource = 0; resource < 100; resource++)
+    {
+        label_t label = builder.push_instruction({"A", resource});
+        ASSERT_GT(builder.approximate_memory_bytes(), empty_memory);
+        builder.pop_head(label);
+        ASSERT_EQ(builder.approximate_memory_bytes(), empty_memory);
+    }
+}
+
+TEST(dependency_dag, remaining_critical_path)
+{
+    DependencyDag<TestInstruction> dag;
+    dag.push_instruction_based_on_commutation({"A", 0});
+    dag.push_instruction_based_on_commutation({"B", 1});
+    dag.push_instruction_based_on_commutation({"C", 0});
+    dag.push_instruction_based_on_commutation({"Long", 0});
+
+    auto remaining = dag.remaining_critical_path([](const TestInstruction& instruction){
+        return instruction.name.size();
+    });
+
+    ASSERT_EQ(remaining.at(0), 6);
+    ASSERT_EQ(remaining.at(1), 1);
+    ASSERT_EQ(remaining.at(2), 5);
+    ASSERT_EQ(remaining.at(3), 4);
+}
+
 TEST(dependency_dag, expand_non_proximate)
 {
     DependencyDag<TestInstruction> dag;
@@ -123,6 +217,31 @@ TEST(dependency_dag, expand_proximate)
     ASSERT_EQ(ss.str(), to_graphviz(dag));
 }
 
+TEST(dependency_dag, expand_inside_proximate_chain)
+{
+    DependencyDag<TestInstruction> dag;
+    dag.push_instruction_based_on_commutation({"A", 0});
+    dag.push_instruction_based_on_commutation({"B", 0});
+
+    dag.expand(1,{{"E", 100}, {"F", 100}}, true);
+    dag.expand(2,{{"G", 100}, {"H", 100}}, true);
+
+    std::stringstream ss;
+    ss << "digraph DirectedGraph {" << std::endl;
+    ss << "  0 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>A 0</b></td></tr><tr><td><font color=\"darkgray\">node: 0</font></td></tr></table>>];" << std::endl;
+    ss << "  3 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>F 100</b></td></tr><tr><td><font color=\"darkgray\">node: 3</font></td></tr></table>>];" << std::endl;
+    ss << "  4 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>G 100</b></td></tr><tr><td><font color=\"darkgray\">node: 4</font></td></tr></table>>];" << std::endl;
+    ss << "  5 [shape=\"plaintext\",label=<<table cellborder=\"0\"><tr><td><b>H 100</b></td></tr><tr><td><font color=\"darkgray\">node: 5</font></td></tr></table>>];" << std::endl;
+    ss << "  0 -> 4;" << std::endl;
+    ss << "  4 -> 5;" << std::endl;
+    ss << "  5 -> 3;" << std::endl;
+    ss << "  4 -> 5 [penwidth=5];" << std::endl;
+    ss << "  5 -> 3 [penwidth=5];" << std::endl;
+    ss << "}" << std::endl;
+
+    ASSERT_EQ(ss.str(), to_graphviz(dag));
+}
+
 
 TEST(dependency_dag, proximate_heads)
 {
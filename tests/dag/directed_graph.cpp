@@ -61,6 +61,38 @@ TEST(directed_graph, add_edge)
 }
 
 
+TEST(directed_graph, remove_node)
+{
+    DirectedGraph g;
+    g.add_edge(0, 1);
+    g.add_edge(1, 2);
+    g.add_edge(0, 2);
+
+    ASSERT_EQ(2, g.in_degree(2));
+    ASSERT_EQ(std::set<label_t>{0}, g.ready_nodes());
+
+    g.remove_node(1);
+    ASSERT_EQ(1, g.in_degree(2));
+    ASSERT_EQ(2, get_edges_for_testing(g).size());
+    ASSERT_EQ(Set<label_t>{2}, get_edges_for_testing(g).at(0));
+    ASSERT_EQ(Set<label_t>{0}, get_back_edges_for_testing(g).at(2));
+    ASSERT_FALSE(g.contains(1));
+    ASSERT_THROW(g.remove_node(1), std::runtime_error);
+
+    g.add_edge(2, 1);
+    ASSERT_EQ(3, get_edges_for_testing(g).size());
+    ASSERT_EQ(Set<label_t>{1}, get_edges_for_testing(g).at(2));
+    ASSERT_EQ(Set<label_t>{}, get_edges_for_testing(g).at(1));
+
+    g.remove_node(0);
+    ASSERT_EQ(std::set<label_t>{2}, g.ready_nodes());
+    g.remove_node(1);
+    g.remove_node(2);
+    ASSERT_TRUE(g.empty());
+    ASSERT_TRUE(g.ready_nodes().empty());
+}
+
+
 TEST(directed_graph, heads_and_tails)
 {
     DirectedGraph g;
@@ -314,3 +346,56 @@ TEST(directed_graph, topological_order_tails_first_3)
     std::vector<label_t> topological_order{1, 2, 3, 4};
     ASSERT_EQ(topological_order, g.topological_order_tails_first());
 }
+
+
+TEST(directed_graph, topological_order_tails_first_long_chain)
+{
+    DirectedGraph g;
+    const label_t chain_length = 1000000;
+    for (label_t i = 1; i < chain_length; i++)
+        g.add_edge(i-1, i);
+
+    auto order = g.topological_order_tails_first();
+    ASSERT_EQ(chain_length, order.size());
+    ASSERT_EQ(chain_length-1, order.front());
+    ASSERT_EQ(0, order.back());
+}
+
+
+TEST(directed_graph, topological_levels)
+{
+    DirectedGraph g;
+    g.add_edge(0, 2);
+    g.add_edge(1, 2);
+    g.add_edge(2, 3);
+    g.add_edge(2, 4);
+    g.add_edge(3, 5);
+    g.add_edge(4, 5);
+    g.add_edge(5, 9);
+    g.add_edge(6, 7);
+    g.add_edge(7, 4);
+    g.add_edge(7, 8);
+    g.add_edge(8, 9);
+    g.add_edge(10, 11);
+    // Same graph as topological_order_tails_first_2
+
+    auto levels = g.topological_levels();
+    ASSERT_EQ(12, levels.order.size());
+    ASSERT_EQ((std::vector<label_t>{0 COMMA 1 COMMA 6 COMMA 10}), std::vector<label_t>(levels.order.begin(), levels.order.begin()+4));
+    ASSERT_EQ(5, levels.depth);
+
+    std::vector<size_t> asap{0, 0, 1, 2, 2, 3, 0, 1, 2, 4, 0, 1};
+    ASSERT_EQ(asap, levels.asap);
+    std::vector<size_t> alap{0, 0, 1, 2, 2, 3, 0, 1, 3, 4, 3, 4};
+    ASSERT_EQ(alap, levels.alap);
+}
+
+
+TEST(directed_graph, topological_levels_with_cycle)
+{
+    DirectedGraph g;
+    g.add_edge(0, 1);
+    g.add_edge(1, 2);
+    g.add_edge(2, 1);
+    ASSERT_THROW(g.topological_levels(), std::runtime_error);
+}
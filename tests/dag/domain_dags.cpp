@@ -16,3 +16,69 @@ TEST(commutation_trait, can_commute)
     ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(0 COMMA 2))); // Same target
     ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(0 COMMA 1))); // All the same
 }
+
+
+TEST(domain_dags, gate_dag_shared_controls)
+{
+    dag::IncrementalDependencyDagBuilder<gates::Gate> builder;
+    builder.push_instruction(gates::CNOT(1 COMMA 0));
+    builder.push_instruction(gates::CNOT(2 COMMA 0));
+    builder.push_instruction(gates::X(0));
+    builder.push_instruction(gates::CNOT(2 COMMA 0));
+    auto dag = builder.release();
+
+    const auto& edges = dag::get_edges_for_testing(dag::get_graph_for_testing(dag));
+    ASSERT_TRUE(edges.at(0).contains(2));
+    ASSERT_TRUE(edges.at(1).contains(2));
+    ASSERT_FALSE(edges.at(0).contains(1)); // Same control
+    ASSERT_TRUE(edges.at(2).contains(3));
+    ASSERT_TRUE(edges.at(1).contains(3)); // Same target
+    ASSERT_FALSE(edges.at(0).contains(3)); // Same control, different targets
+}
+
+
+namespace {
+
+LSInstruction two_patch_measurement(PatchId a, PauliOperator a_op, PatchId b, PauliOperator b_op)
+{
+    return {.operation=MultiPatchMeasurement{.observable={{a, a_op}, {b, b_op}}, .is_negative=false}};
+}
+
+LSInstruction single_qubit_op(PatchId target, SingleQubitOp::Operator op)
+{
+    return {.operation=SingleQubitOp{.target=target, .op=op}};
+}
+
+}
+
+TEST(commutation_trait, ls_instruction_pauli_commutation)
+{
+    auto zz = two_patch_measurement(0, PauliOperator::Z, 1, PauliOperator::Z);
+    auto z = single_qubit_op(0, SingleQubitOp::Operator::Z);
+    auto xx = two_patch_measurement(0, PauliOperator::X, 2, PauliOperator::X);
+
+    ASSERT_FALSE(dag::CommutationTrait<LSInstruction>{}.can_commute(zz, z));
+
+    dag::CommutationTrait<LSInstruction> pauli_commutation{true};
+    ASSERT_TRUE(pauli_commutation.can_commute(zz, z));
+    ASSERT_FALSE(pauli_commutation.can_commute(zz, xx));
+    ASSERT_FALSE(pauli_commutation.can_commute(z, single_qubit_op(0, SingleQubitOp::Operator::H)));
+}
+
+TEST(domain_dags, ls_instruction_dag_pauli_commutation)
+{
+    dag::IncrementalDependencyDagBuilder<LSInstruction> builder{dag::ResourceAccessTrait<LSInstruction>{true}};
+    builder.push_instruction(two_patch_measurement(0, PauliOperator::Z, 1, PauliOperator::Z));
+    builder.push_instruction(single_qubit_op(0, SingleQubitOp::Operator::Z));
+    builder.push_instruction(two_patch_measurement(0, PauliOperator::X, 2, PauliOperator::X));
+    builder.push_instruction(two_patch_measurement(0, PauliOperator::Z, 3, PauliOperator::Z));
+    auto dag = builder.release();
+
+    const auto& edges = dag::get_edges_for_testing(dag::get_graph_for_testing(dag));
+    ASSERT_FALSE(edges.at(0).contains(1)); // Both Z on patch 0
+    ASSERT_TRUE(edges.at(0).contains(2));
+    ASSERT_TRUE(edges.at(1).contains(2)); // X waits for the whole Z group
+    ASSERT_TRUE(edges.at(2).contains(3));
+    ASSERT_FALSE(edges.at(0).contains(3)); // Implied by transitivity
+    ASSERT_FALSE(edges.at(1).contains(3));
+}
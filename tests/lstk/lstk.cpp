@@ -44,6 +44,18 @@ TEST(split_on, string_no_match)
     ASSERT_EQ(1,splits1.size());
 }
 
+TEST(Splitter, same_pieces_as_split_on)
+{
+    for(std::string_view input : {"", ",", "a", "a,b,c", "a,b,c,", ",a,,b", ",,"})
+    {
+        std::vector<std::string_view> pieces;
+        lstk::Splitter splitter{input, ','};
+        while(splitter.has_next())
+            pieces.push_back(splitter.next());
+        ASSERT_EQ(lstk::split_on(input, ','), pieces) << "input: \"" << input << "\"";
+    }
+}
+
 TEST(split_on, pi_over_group)
 {
     std::string input = "3*pi/2";